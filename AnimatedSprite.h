@@ -3,13 +3,15 @@
 
 // Local inc
 #include "sprite.h"
+#include "spritebatch.h"
 
 // Lib includes
 #include <functional> // for std::functional
 
 // Forward dec
 class Renderer;
-class VertexArray;
+class TextureManager;
+struct FrameTable;
 
 // Class dec
 class AnimatedSprite : public Sprite
@@ -20,6 +22,7 @@ public:
 	~AnimatedSprite();
 
 	bool Initialise(Texture& texture);
+	void SetTextureManager(TextureManager* pTextureManager);
 	void SetupFrames(int fixedFrameWidth, int fixedFrameHeight);
 	void Process(float deltaTime);
 	void Draw(Renderer& renderer);
@@ -49,6 +52,8 @@ public:
 	void SetCurrentFrame(int frameIndex);
 	int GetCurrentFrame() const;
 	int GetTotalFrames() const;
+	const SpriteUVRect& GetFrameUVs(int frameIndex) const;
+	const FrameTable& GetFrameTable() const;
 
 protected:
 
@@ -60,7 +65,8 @@ private:
 public:
 
 protected:
-	VertexArray* m_pVertexData;
+	TextureManager* m_pTextureManager;
+	const FrameTable* m_pFrameTable;
 	int m_iFrameWidth;
 	int m_iFrameHeight;
 	int m_iCurrentFrame;
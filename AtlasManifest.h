@@ -0,0 +1,94 @@
+// COMP710 GP Framework 2025
+#ifndef __ATLASMANIFEST_H_
+#define __ATLASMANIFEST_H_
+
+// Library includes:
+#include <string>
+#include <vector>
+#include <map>
+#include <iosfwd>
+
+// Where one original image ended up, in pixels on its page
+struct AtlasRegion
+{
+	unsigned short page;
+	unsigned short x;
+	unsigned short y;
+	unsigned short width;
+	unsigned short height;
+};
+
+// Opaque bounds of one frame in pixels, from the frame's top left. Empty when nothing in it is visible.
+struct FrameTrim
+{
+	int x;
+	int y;
+	int width;
+	int height;
+};
+
+// Every frame's trim of a sprite sheet cut at one frame size, in row order
+struct AtlasFrameTrims
+{
+	int frameWidth;
+	int frameHeight;
+	std::vector<FrameTrim> trims;
+};
+
+// Binary index written by the atlas packer: the page images, for every packed source image (by
+// the path the game loads it with) its page and rectangle, and for every sprite sheet listed with
+// a frame size its frames' trims. Paths are compared lower case with forward slashes, so
+// "assets/Boss/Hurt.png" and "assets/boss/Hurt.png" are the same image.
+//
+// Layout, little endian: "ATL2", u32 page count, pages as (u16 length, chars),
+// u32 region count, regions as (u16 length, chars, u16 page, u16 x, u16 y, u16 width, u16 height),
+// u32 sheet count, sheets as (u16 length, chars, u16 frame width, u16 frame height,
+// u32 frame count, frames as (u16 x, u16 y, u16 width, u16 height)).
+class AtlasManifest
+{
+	// Member methods:
+public:
+	AtlasManifest();
+	~AtlasManifest();
+
+	bool Load(const char* pcFilename);
+	bool Save(const char* pcFilename) const;
+
+	void AddPage(const std::string& pagePath);
+	void AddRegion(const char* pcSourcePath, const AtlasRegion& region);
+	void AddFrameTrims(const char* pcSourcePath, const AtlasFrameTrims& frameTrims);
+
+	unsigned int GetPageCount() const;
+	const std::string& GetPagePath(unsigned int page) const;
+	const AtlasRegion* FindRegion(const char* pcSourcePath) const;
+	const AtlasFrameTrims* FindFrameTrims(const char* pcSourcePath) const;
+
+	static std::string NormalisePath(const char* pcPath);
+
+protected:
+	static bool ReadU16(std::istream& stream, unsigned short& value);
+	static bool ReadU32(std::istream& stream, unsigned int& value);
+	static bool ReadString(std::istream& stream, std::string& value);
+	static void WriteU16(std::ostream& stream, unsigned short value);
+	static void WriteU32(std::ostream& stream, unsigned int value);
+	static void WriteString(std::ostream& stream, const std::string& value);
+
+private:
+	AtlasManifest(const AtlasManifest& atlasManifest);
+	AtlasManifest& operator=(const AtlasManifest& atlasManifest);
+
+	// Member data:
+public:
+
+protected:
+	static const char MANIFEST_MAGIC[4];
+
+	std::vector<std::string> m_pages;
+	std::map<std::string, AtlasRegion> m_regions;
+	std::map<std::string, AtlasFrameTrims> m_frameTrims;
+
+private:
+
+};
+
+#endif // __ATLASMANIFEST_H_
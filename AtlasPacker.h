@@ -0,0 +1,61 @@
+// COMP710 GP Framework 2025
+#ifndef __ATLASPACKER_H_
+#define __ATLASPACKER_H_
+
+// Library includes:
+#include <string>
+#include <vector>
+
+// Forward Declarations:
+struct SDL_Surface;
+
+// Build step, run the game with -buildatlas from the game directory: packs the images
+// listed in assets/atlas/sources.txt into a few atlas pages with the stb rect packer, and writes
+// the pages plus an AtlasManifest that the TextureManager resolves the original paths through.
+// Sprite sheets listed with their frame size also have every frame trimmed to its opaque bounds
+// here, so the game doesn't read them back from GL to trim them as they load.
+class AtlasPacker
+{
+	// Member methods:
+public:
+	AtlasPacker();
+	~AtlasPacker();
+
+	// One path per line, as the game loads it, then the frame width and height for a sprite sheet.
+	// Blank lines and lines starting with '#' are skipped.
+	bool AddSourceList(const char* pcListFilename);
+	bool AddImage(const char* pcPath, int frameWidth = 0, int frameHeight = 0);
+
+	// Writes page0.png, page1.png... and atlas.bin into pcOutputDirectory
+	bool Build(const char* pcOutputDirectory, int pageSize);
+
+	static int RunBuildStep();
+
+protected:
+
+private:
+	AtlasPacker(const AtlasPacker& atlasPacker);
+	AtlasPacker& operator=(const AtlasPacker& atlasPacker);
+
+	// Member data:
+public:
+
+protected:
+	struct SourceImage
+	{
+		std::string path;
+		SDL_Surface* pSurface;
+		int frameWidth; // 0 when the image isn't a sprite sheet
+		int frameHeight;
+	};
+
+	std::vector<SourceImage> m_sources;
+
+	// Empty pixels between packed images, so nothing bleeds into a neighbour at its edges
+	static const int PADDING = 2;
+
+private:
+
+};
+
+#endif // __ATLASPACKER_H_
@@ -54,11 +54,17 @@ Boss::Boss()
     , m_pSpellEffectTexture_Windup(nullptr)
     , m_pSpellEffectTexture_Strike(nullptr)
     , m_pSpellEffectTexture_Over(nullptr)
+    , m_pTextureManager(nullptr)
     , m_spellTargetPosition()
     , m_spellPhaseTimer(0.0f) // Timer for the duration of SPELL_WINDUP, SPELL_STRIKE, SPELL_OVER states
     , m_bSpellDamageDealtThisCast(false)
 {
     SetMaxHealth(1500, true); // Enemy specific health
+
+    for (int i = 0; i < NUM_SPELL_PHASES; ++i)
+    {
+        m_pSpellFrameTables[i] = nullptr;
+    }
 }
 
 Boss::~Boss()
@@ -71,6 +77,9 @@ Boss::~Boss()
         delete pair.second;
     }
     m_animatedSprites.clear();
+
+    ReleaseSpellFrameTables();
+
     m_pTargetPlayer = nullptr;
     m_pSceneRef = nullptr;
 }
@@ -133,6 +142,8 @@ bool Boss::Initialise(Renderer& renderer, const Vector2& startPosition)
         {
             LogManager::GetInstance().Log("Boss::Initialise - WARNING: Failed to load one or more spell effect textures via TextureManager. Spell visuals might not work.");
         }
+
+        AcquireSpellFrameTables(renderer.GetTextureManager());
     }
     else 
     {
@@ -141,7 +152,7 @@ bool Boss::Initialise(Renderer& renderer, const Vector2& startPosition)
     }
 
     delete m_pSpellEffectSprite; // Delete if re-initializing
-    m_pSpellEffectSprite = new AnimatedSprite();
+    m_pSpellEffectSprite = renderer.CreateAnimatedSprite("assets/boss/Cast_Windup.png"); // Texture is swapped per spell phase
     if (!m_pSpellEffectSprite) 
     {
         LogManager::GetInstance().Log("Boss::Initialise - Failed to new AnimatedSprite for spell effect.");
@@ -411,7 +422,10 @@ void Boss::Draw(Renderer& renderer)
             m_currentState == BossState::SPELL_STRIKE ||
             m_currentState == BossState::SPELL_OVER))
     {
+        RenderLayer previousLayer = renderer.GetLayer();
+        renderer.SetLayer(RenderLayer::FX);
         m_pSpellEffectSprite->Draw(renderer);
+        renderer.SetLayer(previousLayer);
     }
 }
 
@@ -611,6 +625,40 @@ void Boss::TransitionToState(BossState newState)
     }
 }
 
+void Boss::AcquireSpellFrameTables(TextureManager* pTextureManager)
+{
+    ReleaseSpellFrameTables(); // Re-initialising
+
+    m_pTextureManager = pTextureManager;
+
+    if (m_pSpellEffectTexture_Windup)
+    {
+        m_pSpellFrameTables[0] = m_pTextureManager->AcquireFrameTable(*m_pSpellEffectTexture_Windup, BOSS_DEFAULT_SPRITE_CASTWINDUP_WIDTH, BOSS_DEFAULT_SPRITE_CASTWINDUP_HEIGHT);
+    }
+    if (m_pSpellEffectTexture_Strike)
+    {
+        m_pSpellFrameTables[1] = m_pTextureManager->AcquireFrameTable(*m_pSpellEffectTexture_Strike, BOSS_DEFAULT_SPRITE_CASTSTRIKE_WIDTH, BOSS_DEFAULT_SPRITE_CASTSTRIKE_HEIGHT);
+    }
+    if (m_pSpellEffectTexture_Over)
+    {
+        m_pSpellFrameTables[2] = m_pTextureManager->AcquireFrameTable(*m_pSpellEffectTexture_Over, BOSS_DEFAULT_SPRITE_CAST_END_WIDTH, BOSS_DEFAULT_SPRITE_CAST_END_HEIGHT);
+    }
+}
+
+void Boss::ReleaseSpellFrameTables()
+{
+    if (!m_pTextureManager)
+    {
+        return;
+    }
+
+    for (int i = 0; i < NUM_SPELL_PHASES; ++i)
+    {
+        m_pTextureManager->ReleaseFrameTable(m_pSpellFrameTables[i]);
+        m_pSpellFrameTables[i] = nullptr;
+    }
+}
+
 void Boss::SetSceneReference(SceneAbyssWalker* scene)
 {
     m_pSceneRef = scene;
@@ -15,6 +15,8 @@ class Player;
 class Renderer;
 class SceneAbyssWalker;
 class Texture;
+class TextureManager;
+struct FrameTable;
 
 enum class BossState
 {
@@ -67,6 +69,9 @@ protected:
 
     void MoveToPlayer(float deltaTime);
 
+    void AcquireSpellFrameTables(TextureManager* pTextureManager);
+    void ReleaseSpellFrameTables();
+
     bool InitialiseAnimatedSprite(
         Renderer& renderer,
         BossState state,
@@ -147,6 +152,12 @@ protected:
     Texture* m_pSpellEffectTexture_Strike;
     Texture* m_pSpellEffectTexture_Over;
 
+    // Held for the boss's lifetime so swapping the spell texture each phase finds its frame table
+    // already built, instead of the swap releasing the last phase's table and rebuilding the next
+    static const int NUM_SPELL_PHASES = 3;
+    TextureManager* m_pTextureManager;
+    const FrameTable* m_pSpellFrameTables[NUM_SPELL_PHASES];
+
     // Where the spell will try and target
     Vector2 m_spellTargetPosition;
 
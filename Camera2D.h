@@ -0,0 +1,53 @@
+// COMP710 GP Framework 2025
+#ifndef __CAMERA2D_H_
+#define __CAMERA2D_H_
+
+// Forward Declarations:
+struct Matrix4;
+
+// Orthographic 2D camera. The position is the world point at the centre of the screen and
+// zoom scales the world about it, so zoom 2.0f shows half as much of the world.
+class Camera2D
+{
+	// Member methods:
+public:
+	Camera2D();
+	~Camera2D();
+
+	void SetViewportSize(float width, float height);
+
+	void SetPosition(float x, float y);
+	float GetX() const;
+	float GetY() const;
+
+	void SetZoom(float zoom);
+	float GetZoom() const;
+
+	void GetVisibleBounds(float& left, float& top, float& right, float& bottom) const;
+	void CreateViewProjection(Matrix4& mat) const;
+
+	// Axis aligned box overlap against the visible world rectangle
+	bool IsVisible(float minX, float minY, float maxX, float maxY) const;
+
+protected:
+
+private:
+	Camera2D(const Camera2D& camera);
+	Camera2D& operator=(const Camera2D& camera);
+
+	// Member data:
+public:
+
+protected:
+	float m_fX;
+	float m_fY;
+	float m_fZoom;
+
+	float m_fViewportWidth;
+	float m_fViewportHeight;
+
+private:
+
+};
+
+#endif // __CAMERA2D_H_
@@ -6,6 +6,7 @@
 #include "Renderer.h"
 #include "LogManager.h"
 #include "Texture.h" 
+#include "TextureManager.h"
 #include "SceneAbyssWalker.h"
 
 //IMGUI
@@ -78,6 +79,18 @@ bool EnemyBat::Initialise(Renderer& renderer, const Vector2& startPosition)
         m_pStaticEnemy->SetScale(ENEMYBAT_VISUAL_SCALE, ENEMYBAT_VISUAL_SCALE);
     }
 
+    // Every state shares one texture array, so a crowd of bats in mixed states never rebinds
+    static const char* const STATE_SHEETS[] =
+    {
+        "assets/enemyBat/Bat-IdleFly.png",
+        "assets/enemyBat/Bat-Run.png",
+        "assets/enemyBat/Bat-Attack1.png",
+        "assets/enemyBat/Bat-Hurt.png",
+        "assets/enemyBat/Bat-Die.png"
+    };
+    const int numStateSheets = static_cast<int>(sizeof(STATE_SHEETS) / sizeof(STATE_SHEETS[0]));
+    renderer.GetTextureManager()->CreateTextureArray("EnemyBat", STATE_SHEETS, numStateSheets, ENEMY_DEFAULT_SPRITE_WIDTH, ENEMY_DEFAULT_SPRITE_HEIGHT);
+
     if (!InitialiseAnimatedSprite(renderer, EnemyBatState::IDLE, "assets/enemyBat/Bat-IdleFly.png", ENEMY_DEFAULT_SPRITE_WIDTH, ENEMY_DEFAULT_SPRITE_HEIGHT, 0.15f, true)) return false;
     if (!InitialiseAnimatedSprite(renderer, EnemyBatState::WALKING, "assets/enemyBat/Bat-Run.png", ENEMY_DEFAULT_SPRITE_WIDTH, ENEMY_DEFAULT_SPRITE_HEIGHT, 0.18f, true)) return false;
     if (!InitialiseAnimatedSprite(renderer, EnemyBatState::ATTACKING, "assets/enemyBat/Bat-Attack1.png", ENEMY_DEFAULT_SPRITE_WIDTH, ENEMY_DEFAULT_SPRITE_HEIGHT, 0.1f, false, [this]() { this->OnAttackAnimationComplete(); })) return false;
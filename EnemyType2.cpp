@@ -6,6 +6,7 @@
 #include "Renderer.h"
 #include "LogManager.h"
 #include "Texture.h" 
+#include "TextureManager.h"
 
 // IMGUI
 #include "imgui/imgui.h"
@@ -78,6 +79,19 @@ bool EnemyType2::Initialise(Renderer& renderer, const Vector2& startPosition)
     m_strikePhaseRadius = (static_cast<float>(ENEMY_DEFAULT_SPRITE_ATTACKSTRIKE_WIDTH) * ENEMYTYPE2_VISUAL_SCALE) / 2.0f;
     SetRadius(m_baseRadius);
 
+    // The states cut at the default frame size share one texture array, the wide strike stays a 2D sheet
+    static const char* const STATE_SHEETS[] =
+    {
+        "assets/enemyType2/Idle.png",
+        "assets/enemyType2/Walk.png",
+        "assets/enemyType2/Attack_Windup.png",
+        "assets/enemyType2/Attack_Over.png",
+        "assets/enemyType2/Hurt.png",
+        "assets/enemyType2/Death.png"
+    };
+    const int numStateSheets = static_cast<int>(sizeof(STATE_SHEETS) / sizeof(STATE_SHEETS[0]));
+    renderer.GetTextureManager()->CreateTextureArray("EnemyType2", STATE_SHEETS, numStateSheets, ENEMY_DEFAULT_SPRITE_WIDTH, ENEMY_DEFAULT_SPRITE_HEIGHT);
+
     if (!InitialiseAnimatedSprite(renderer, EnemyType2State::IDLE, "assets/enemyType2/Idle.png", ENEMY_DEFAULT_SPRITE_WIDTH, ENEMY_DEFAULT_SPRITE_HEIGHT, 0.1f, true)) return false;
     if (!InitialiseAnimatedSprite(renderer, EnemyType2State::WALKING, "assets/enemyType2/Walk.png", ENEMY_DEFAULT_SPRITE_WIDTH, ENEMY_DEFAULT_SPRITE_HEIGHT, 0.15f, true)) return false;
     // Attack Sequence Section
@@ -0,0 +1,124 @@
+// COMP710 GP Framework 2025
+#ifndef __FRAMECAPTURE_H_
+#define __FRAMECAPTURE_H_
+
+// Library includes:
+#include <SDL.h>
+#include <glew.h>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Screenshots and gameplay recording without stalling on glReadPixels. Frame N is read into one of
+// a ring of pixel buffer objects, mapped at frame N+2 once the GPU has long finished the copy, and
+// handed to a writer thread that saves a PNG or appends the frame to an uncompressed Y4M stream.
+class FrameCapture
+{
+	// Member methods:
+public:
+	FrameCapture();
+	~FrameCapture();
+
+	bool Initialise();
+
+	// With the render context current and the render thread stopped: finishes every capture in flight
+	void Shutdown();
+
+	// Any thread: taken up by the next frame the render thread draws
+	void StartRecording(const char* pcFilename, int framesPerSecond);
+	void StopRecording();
+	bool IsRecording() const;
+
+	// Render thread, once the frame is drawn: framebuffer 0 reads the window's back buffer.
+	// A screenshot path comes with the frame it was asked for in, so it can't land on the frame before.
+	void CaptureFrame(GLuint framebuffer, int width, int height, const std::string& screenshotPath);
+
+protected:
+	enum class CaptureJobType
+	{
+		SCREENSHOT,
+		VIDEO_START,
+		VIDEO_FRAME,
+		VIDEO_END
+	};
+
+	struct CaptureJob
+	{
+		CaptureJobType type;
+		std::string path;
+		int width;
+		int height;
+		int framesPerSecond;
+		std::vector<unsigned char> pixels; // RGBA8, bottom row first as GL reads it
+	};
+
+	struct CaptureSlot
+	{
+		GLuint glBuffer;
+		GLsizeiptr bufferSize;
+		GLsync fence;
+		int width;
+		int height;
+		std::string screenshotPath;
+		bool bVideoFrame;
+		bool bPending;
+	};
+
+	void ReadBack(CaptureSlot& slot);
+	void ReadBackAll();
+	void QueueJob(CaptureJob* pJob);
+
+	static int WriterThreadMain(void* pData);
+	void RunWriter();
+	void WriteJob(const CaptureJob& job);
+	static bool WritePng(const CaptureJob& job);
+	void WriteY4mFrame(const CaptureJob& job);
+
+private:
+	FrameCapture(const FrameCapture& frameCapture);
+	FrameCapture& operator=(const FrameCapture& frameCapture);
+
+	// Member data:
+public:
+
+protected:
+	// Frame N is mapped at N+2, the third slot is the one being written this frame
+	static const int CAPTURE_SLOTS = 3;
+
+	// Video frames waiting on the writer before new ones are dropped, a slow disk mustn't eat all memory
+	static const int MAX_QUEUED_VIDEO_FRAMES = 8;
+
+	SDL_Thread* m_pWriterThread;
+	SDL_mutex* m_pMutex;
+	SDL_cond* m_pJobReady;
+
+	// Guarded by m_pMutex: requests from the game thread, and the writer's queue
+	std::string m_recordingRequest;
+	int m_iRequestedFramesPerSecond;
+	bool m_bRecordingRequested;
+	bool m_bRecordingRestarted;
+	std::deque<CaptureJob*> m_jobs;
+	int m_iQueuedVideoFrames;
+	bool m_bQuit;
+
+	// Render thread only
+	CaptureSlot m_slots[CAPTURE_SLOTS];
+	unsigned int m_uiFrame;
+	bool m_bRecording;
+	int m_iDroppedFrames;
+
+	// Writer thread only: the open Y4M stream
+	std::ofstream m_videoFile;
+	std::string m_videoPath;
+	int m_iVideoWidth;
+	int m_iVideoHeight;
+	int m_iVideoFramesPerSecond;
+	int m_iVideoFrames;
+	std::vector<unsigned char> m_yuvPlanes;
+
+private:
+
+};
+
+#endif // __FRAMECAPTURE_H_
@@ -0,0 +1,73 @@
+// COMP710 GP Framework 2025
+#ifndef __FRAMEPACER_H_
+#define __FRAMEPACER_H_
+
+// Library includes:
+#include <SDL.h>
+
+// Holds the game loop to a frame rate cap once a frame has been presented, and measures how
+// evenly frames are presented. Waits sleep while the deadline is far off and spin for the last
+// moment, so the cap is kept to well under a millisecond without burning a core. While the window
+// is in the background the (much lower) background cap applies instead.
+class FramePacer
+{
+	// Member methods:
+public:
+	FramePacer();
+	~FramePacer();
+
+	// Asks the OS for 1 ms sleeps for as long as the pacer runs
+	void Initialise();
+	void Shutdown();
+
+	// Frames per second, 0 leaves the loop uncapped (vsync may still pace it)
+	void SetFrameCap(int framesPerSecond);
+	int GetFrameCap() const;
+	void SetBackgroundFrameCap(int framesPerSecond);
+	int GetBackgroundFrameCap() const;
+
+	void SetFocused(bool focused);
+	bool IsThrottled() const;
+
+	// Once a frame, straight after Present: records the present-to-present time, then waits out the cap
+	void EndFrame();
+
+	// Over the last HISTORY_FRAMES presents: mean interval, its standard deviation and the longest
+	void GetTimings(float& averageMilliseconds, float& jitterMilliseconds, float& worstMilliseconds) const;
+
+protected:
+	int GetActiveCap() const;
+	void WaitUntil(Uint64 deadline);
+	void RecordInterval(float milliseconds);
+
+private:
+	FramePacer(const FramePacer& framePacer);
+	FramePacer& operator=(const FramePacer& framePacer);
+
+	// Member data:
+public:
+
+protected:
+	// Frames in the timings, two seconds at 60Hz
+	static const int HISTORY_FRAMES = 120;
+
+	// Left to spin rather than sleep, sleeps can wake up this late even at 1 ms resolution
+	static const int SPIN_MICROSECONDS = 2000;
+
+	int m_iFrameCap;
+	int m_iBackgroundFrameCap;
+	bool m_bFocused;
+	bool m_bInitialised;
+
+	Uint64 m_iNextFrameTime; // 0 when no cap was applied last frame
+	Uint64 m_iLastPresentTime;
+
+	float m_history[HISTORY_FRAMES];
+	int m_iHistoryNext;
+	int m_iHistoryCount;
+
+private:
+
+};
+
+#endif // __FRAMEPACER_H_
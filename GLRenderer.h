@@ -0,0 +1,179 @@
+// COMP710 GP Framework 2024
+#ifndef __GLRENDERER_H_
+#define __GLRENDERER_H_
+
+// Forward Declarations:
+class Shader;
+class SpriteBatch;
+class ShapeBatch;
+struct SDL_Window;
+class FrameCapture;
+struct Matrix4;
+struct SpriteInstance;
+struct SpriteRotation;
+
+// Local includes:
+#include "Renderer.h"
+#include "RenderThread.h"
+#include "GLStateCache.h"
+#include "GpuTimer.h"
+#include "RenderStats.h"
+
+// Library includes:
+#include <SDL.h>
+#include <glew.h>
+
+// The OpenGL 3.3 backend: records draws on the game thread and replays them on the render thread.
+class GLRenderer : public Renderer
+{
+	// Member methods:
+public:
+	GLRenderer();
+	virtual ~GLRenderer();
+
+	// Optional, before Initialize: the window is created hidden, for offscreen runs (RenderHarness)
+	void SetHiddenWindow(bool hidden);
+	virtual bool Initialize(bool windowed, int width = 0, int height = 0);
+
+	virtual void Clear();
+	virtual void Present();
+
+	// Render thread only: draws a recorded frame and swaps
+	void ExecuteFrame(RenderFrame& frame);
+
+	virtual void GetCanvasPlacement(float& x, float& y, float& scale) const;
+
+	virtual void DrawSprite(Sprite& sprite, bool FlipHorizontal = false);
+	virtual void DrawAnimatedSprite(AnimatedSprite& sprite, int frame, bool FlipHorizontal = false);
+
+	virtual void DrawFilledRect(float x1, float y1, float x2, float y2, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+	virtual void DrawOutlinedRect(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+	virtual void DrawLine(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+
+	virtual int AcquireCachedLayer();
+	virtual void ReleaseCachedLayer(int cachedLayer);
+	virtual bool BeginCachedLayer(int cachedLayer, unsigned int contentKey);
+	virtual void EndCachedLayer();
+	virtual void DrawCachedLayer(int cachedLayer);
+
+	virtual void CaptureScreenshot(const char* pcFilename);
+	virtual void StartRecording(const char* pcFilename, int framesPerSecond = 60);
+	virtual void StopRecording();
+	virtual bool IsRecording() const;
+
+	virtual GpuTimer* GetGpuTimer();
+
+	virtual void GetFrameStats(RenderStats& stats);
+
+protected:
+	bool InitializeOpenGL(int screenWidth, int screenHeight);
+	void SetFullscreen(bool fullscreen);
+
+	void LogSdlError();
+	void ApplyVsyncMode(VsyncMode mode);
+
+	bool SetupSpriteShader();
+	bool SetupShapeShader();
+	void BindShaderUniforms(Shader& shader);
+	void ReloadChangedShaders();
+	struct CachedLayer;
+	void CreateCachedLayerTexture(CachedLayer& layer);
+	void UpdateCachedLayers(RenderFrame& frame);
+
+	void SetupCanvas();
+	void PresentCanvas();
+	void SetupCameraBuffer();
+	void UploadCameraBuffer(const Matrix4& viewProj);
+	static bool IsCameraLayer(RenderLayer layer);
+	static GpuPass GetGpuPass(RenderLayer layer);
+
+	void QueueSprite(unsigned int textureId, const SpriteInstance& instance, const SpriteRotation& rotation, RenderProgram program = RenderProgram::SPRITE);
+	void QueueShape(ShapeType type, float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+	// timePasses: each layer's draws are timed and counted as their GpuPass, for the frame's own queue
+	void SubmitRenderQueue(RenderQueue& renderQueue, bool timePasses = false);
+	void FlushBatches(RenderProgram program);
+	static void CreateSpriteInstance(SpriteInstance& instance, const Sprite& sprite, float sizeX, float sizeY, bool flipHorizontal);
+
+private:
+	GLRenderer(const GLRenderer& renderer);
+	GLRenderer& operator=(const GLRenderer& renderer);
+
+	// Member data:
+public:
+
+protected:
+	SDL_Window* m_pWindow;
+	SDL_GLContext m_glContext;
+
+	Shader* m_pSpriteShader;
+	SpriteBatch* m_pSpriteBatch;
+
+	Shader* m_pSpriteArrayShader;
+	SpriteBatch* m_pSpriteArrayBatch;
+
+	// Palette atlas owned by the TextureManager, looked up by the sprite shaders for indexed textures
+	static const GLuint PALETTE_TEXTURE_UNIT = 1;
+	GLuint m_glPaletteTexture;
+
+	Shader* m_pShapeShader;
+	ShapeBatch* m_pShapeBatch;
+
+	// Debug builds relink shaders whose files changed, checked every so often by the render thread
+	unsigned int m_uiLastShaderPoll;
+
+	RenderQueue* m_pRenderQueue; // The frame being recorded, owned by RenderThread
+
+	// Uniform buffers bound to the Camera block in sprite.vert and shape.vert:
+	// the camera's view/projection, re-uploaded each frame, and a fixed screen space one
+	static const GLuint CAMERA_UNIFORM_BINDING = 0;
+	GLuint m_glCameraBuffer;
+	GLuint m_glScreenBuffer;
+
+	FrameCapture* m_pFrameCapture;
+	GpuTimer* m_pGpuTimer;
+
+	bool m_bHiddenWindow;
+
+	// Render thread: the pass draws are being made in
+	GpuPass m_currentPass;
+
+	// Render thread: the swap interval the context was last given
+	VsyncMode m_appliedVsyncMode;
+
+	// The last frame the render thread finished, read by the game thread
+	SDL_mutex* m_pStatsMutex;
+	RenderStats m_frameStats;
+
+	int m_iWindowWidth;
+	int m_iWindowHeight;
+
+	GLuint m_glCanvasFramebuffer;
+	GLuint m_glCanvasTexture;
+	float m_fCanvasX;
+	float m_fCanvasY;
+	float m_fCanvasScale;
+
+	// Game thread side of the cached layers; the framebuffers belong to the render thread
+	struct CachedLayer
+	{
+		unsigned int glTexture;
+		int iWidth;
+		int iHeight;
+		unsigned int contentKey;
+		bool bInUse;
+		bool bValid;
+	};
+
+	CachedLayer m_cachedLayers[RenderFrame::MAX_CACHED_LAYERS];
+	GLuint m_cachedLayerFramebuffers[RenderFrame::MAX_CACHED_LAYERS];
+	RenderQueue* m_pFrameRenderQueue; // Set aside while a cached layer is being recorded
+	int m_iRecordingCachedLayer;
+
+	// Render thread: ALPHA, or ALPHA_TO_LAYER while rendering into a cached layer
+	BlendMode m_drawBlendMode;
+
+private:
+
+};
+
+#endif // __GLRENDERER_H_
\ No newline at end of file
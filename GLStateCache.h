@@ -0,0 +1,75 @@
+// COMP710 GP Framework 2025
+#ifndef __GLSTATECACHE_H_
+#define __GLSTATECACHE_H_
+
+// Local includes:
+#include "RenderStats.h"
+
+enum class BlendMode
+{
+	UNKNOWN,
+	NONE,
+	ALPHA,
+	ALPHA_TO_LAYER, // Straight alpha draws accumulated into a premultiplied offscreen layer
+	PREMULTIPLIED
+};
+
+// Shadows the GL state the renderer changes every frame, so redundant binds are skipped
+// without ever asking the driver what is currently bound. One instance per thread, since
+// each thread that touches GL has its own context.
+class GLStateCache
+{
+	// Member methods:
+public:
+	static GLStateCache& GetInstance();
+	static void DestroyInstance();
+
+	void UseProgram(unsigned int program);
+	void BindVertexArray(unsigned int vertexArray);
+	void BindTexture(unsigned int unit, unsigned int texture);
+	void BindTextureArray(unsigned int unit, unsigned int texture);
+	void SetBlendMode(BlendMode mode);
+
+	// Objects deleted while bound are unbound by GL, keep the shadow copy in step
+	void OnProgramDeleted(unsigned int program);
+	void OnVertexArrayDeleted(unsigned int vertexArray);
+	void OnTextureDeleted(unsigned int texture);
+
+	// Call after code outside the renderer (e.g. ImGui) has changed GL state
+	void Invalidate();
+
+	// This thread's counts since they were last reset
+	RenderStats& GetStats();
+
+protected:
+
+private:
+	GLStateCache();
+	~GLStateCache();
+	GLStateCache(const GLStateCache& stateCache);
+	GLStateCache& operator=(const GLStateCache& stateCache);
+
+	// Member data:
+public:
+	static const unsigned int MAX_TEXTURE_UNITS = 8;
+
+protected:
+	static thread_local GLStateCache* sm_pInstance;
+
+	// Sentinel for "not known", never a valid GL name
+	static const unsigned int UNKNOWN_BINDING = 0xFFFFFFFF;
+
+	unsigned int m_program;
+	unsigned int m_vertexArray;
+	unsigned int m_activeTextureUnit;
+	unsigned int m_textures[MAX_TEXTURE_UNITS];
+	unsigned int m_textureArrays[MAX_TEXTURE_UNITS]; // GL_TEXTURE_2D_ARRAY is bound separately from GL_TEXTURE_2D
+	BlendMode m_blendMode;
+
+	RenderStats m_stats;
+
+private:
+
+};
+
+#endif // __GLSTATECACHE_H_
@@ -11,6 +11,8 @@
 class Renderer;
 class Scene;
 class InputSystem;
+class FramePacer;
+enum class VsyncMode;
 
 // Lib includes
 #include <vector>
@@ -22,16 +24,32 @@ const int SCENE_INDEX_AUTSPLASH = 1;
 const int SCENE_INDEX_TITLE = 2;
 const int SCENE_INDEX_ABYSSWALKER = 3;
 
+enum class GameRunMode
+{
+	PLAY,
+	NULL_RENDERER,		// No window or GL (soak tests, simulation benchmarks)
+	RENDER_HARNESS		// GL into a hidden window (RenderHarness)
+};
+
 class Game
 {
 	// Member methods:
 public:
 	static Game& GetInstance();
 	static void DestroyInstance();
-	bool Initialise();
+	// Besides PLAY, the game goes straight into SceneAbyssWalker and steps at a fixed 60Hz,
+	// so runs are repeatable and don't depend on how fast the machine is
+	bool Initialise(GameRunMode runMode = GameRunMode::PLAY);
 	bool DoGameLoop();
 	void Quit();
 
+	// Quit after this many frames and log how long they took, 0 runs until quit
+	void SetFrameLimit(int frames);
+
+	// Before Initialise, PLAY only: test runs go as fast as they can. A cap of 0 leaves pacing to vsync.
+	void SetFrameCap(int framesPerSecond);
+	void SetVsyncMode(VsyncMode mode);
+
 	//IMGUI
 	void ToggleDebugWindow();
 
@@ -44,6 +62,7 @@ public:
 	static bool s_bInfiniteStaminaMode;
 
 	InputSystem* GetInputSystem();
+	Renderer* GetRenderer();
 
 protected:
 	void Process(float deltaTime);
@@ -54,6 +73,9 @@ protected:
 	
 	//IMGUI
 	void DebugDraw();
+	void DebugDrawGpuTime();
+	void DebugDrawRenderStats();
+	void DebugDrawFramePacing();
 
 private:
 	Game();
@@ -69,6 +91,7 @@ protected:
 	static Game* sm_pInstance;
 	Renderer* m_pRenderer;
 	InputSystem* m_pInputSystem;
+	FramePacer* m_pFramePacer;
 
 	bool m_bShowDebugWindow;
 
@@ -90,6 +113,17 @@ protected:
 
 	bool m_bLooping;
 
+	GameRunMode m_runMode;
+	int m_iFrameLimit;
+	int m_iFramesRun;
+	__int64 m_iRunStartTime;
+
+	int m_iFrameCap;
+	VsyncMode m_vsyncMode;
+
+	// Frames per second while the window is in the background
+	static const int BACKGROUND_FRAME_CAP = 15;
+
 private:
 
 };
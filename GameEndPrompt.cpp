@@ -334,7 +334,7 @@ void GameEndPrompt::Draw(Renderer& renderer)
     float panelX = m_pRenderer->GetWidth() / 2.0f - panelWidth / 2.0f;
     float panelY = m_pRenderer->GetHeight() / 2.0f - panelHeight / 2.0f; // Center panel better
 
-    renderer.DrawDebugRect(panelX, panelY, panelX + panelWidth, panelY + panelHeight, 15, 15, 15, 235);
+    renderer.DrawFilledRect(panelX, panelY, panelX + panelWidth, panelY + panelHeight, 15, 15, 15, 235);
 
     if (m_pGameEndTitleSprite) m_pGameEndTitleSprite->Draw(renderer);
     if (m_pGameEndReviveCostSprite) m_pGameEndReviveCostSprite->Draw(renderer);
@@ -347,7 +347,7 @@ void GameEndPrompt::Draw(Renderer& renderer)
         { // Use selected index for highlight
             r = 70; g = 70; b = 75;
         }
-        renderer.DrawDebugRect(btn.rect.x, btn.rect.y,
+        renderer.DrawFilledRect(btn.rect.x, btn.rect.y,
             btn.rect.x + btn.rect.width, btn.rect.y + btn.rect.height,
             r, g, b, a);
         if (btn.textSprite) 
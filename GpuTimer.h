@@ -0,0 +1,93 @@
+// COMP710 GP Framework 2025
+#ifndef __GPUTIMER_H_
+#define __GPUTIMER_H_
+
+// Library includes:
+#include <SDL.h>
+#include <glew.h>
+
+// The render passes a frame is timed in, in the order they are listed in the debug window.
+// CLEAR includes re-recording cached layers and uploading the camera, HUD includes MENU,
+// PRESENT is scaling the canvas up to the window and the capture readback.
+enum class GpuPass
+{
+	CLEAR,
+	BACKGROUND,
+	WORLD,
+	FX,
+	HUD,
+	IMGUI,
+	PRESENT,
+	COUNT
+};
+
+// GPU time per render pass from GL_TIME_ELAPSED queries. Each frame uses its own set of queries
+// from a small ring and only reads them back when the set comes round again, a few frames later,
+// by which time the GPU has finished with them, so timing never stalls the render thread.
+class GpuTimer
+{
+	// Member methods:
+public:
+	GpuTimer();
+	~GpuTimer();
+
+	static const int PASS_COUNT = static_cast<int>(GpuPass::COUNT);
+
+	// With the render context current. Returns false, and times nothing, without timer queries.
+	bool Initialise();
+	void Shutdown();
+
+	// Render thread: one pass runs at a time, beginning a pass ends the one before
+	void BeginFrame();
+	void BeginPass(GpuPass pass);
+	void EndFrame();
+
+	// Any thread: milliseconds per pass, averaged over the last frames read back
+	void GetAverages(float (&milliseconds)[PASS_COUNT]) const;
+	static const char* GetPassName(GpuPass pass);
+
+protected:
+	struct QuerySet
+	{
+		GLuint queries[PASS_COUNT];
+		bool used[PASS_COUNT];
+		int lastPass;
+		bool bPending;
+	};
+
+	bool ReadBack(QuerySet& querySet);
+
+private:
+	GpuTimer(const GpuTimer& gpuTimer);
+	GpuTimer& operator=(const GpuTimer& gpuTimer);
+
+	// Member data:
+public:
+
+protected:
+	// Results are read this many frames after they were queried
+	static const int QUERY_FRAMES = 4;
+
+	// Frames in the rolling average, about a second at 60Hz
+	static const int HISTORY_FRAMES = 60;
+
+	// Render thread only
+	QuerySet m_querySets[QUERY_FRAMES];
+	int m_iCurrentSet;
+	int m_iActivePass;
+	bool m_bTiming;
+	bool m_bInitialised;
+
+	float m_history[HISTORY_FRAMES][PASS_COUNT];
+	int m_iHistoryNext;
+	int m_iHistoryCount;
+
+	// Guarded by m_pMutex, read by the game thread's debug window
+	SDL_mutex* m_pMutex;
+	float m_averages[PASS_COUNT];
+
+private:
+
+};
+
+#endif // __GPUTIMER_H_
@@ -39,6 +39,10 @@ public:
 	ButtonState GetMouseButtonState(int button);
 	void ShowMouseCursor(bool show);
 	void SetRelativeMode(bool relative);
+	void SetMouseCanvas(float x, float y, float scale);
+
+	// Window
+	bool IsWindowFocused() const;
 
 	// Xbox Controllers
 	int GetNumberOfControllersAttached() const;
@@ -64,6 +68,13 @@ protected:
 	unsigned int m_currentMouseButtons;
 	bool m_bRelativeMouseMode;
 
+	// Maps window pixels onto the renderer's canvas
+	float m_fMouseCanvasX;
+	float m_fMouseCanvasY;
+	float m_fMouseCanvasScale;
+
+	bool m_bWindowFocused;
+
 	XboxController* m_pXboxController;
 	int m_iNumAttachedControllers;
 
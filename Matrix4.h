@@ -10,5 +10,6 @@ struct Matrix4
 void SetZero(Matrix4& mat);
 void SetIdentity(Matrix4& mat);
 void CreateOrthoProjection(Matrix4& mat, float width, float height);
+void CreateOrthoProjection(Matrix4& mat, float left, float top, float right, float bottom);
 
 #endif // __MATRIX4_H_
\ No newline at end of file
@@ -0,0 +1,77 @@
+// COMP710 GP Framework 2025
+#ifndef __NULLRENDERER_H_
+#define __NULLRENDERER_H_
+
+// Local includes:
+#include "Renderer.h"
+
+// Library includes:
+#include <vector>
+
+// Renderer for machines without a GPU: no window and no GL context. Textures and sprites are still
+// created, with their real sizes read from the image headers, so gameplay, layout and animation
+// run exactly as they would on screen. Draws are dropped.
+class NullRenderer : public Renderer
+{
+	// Member methods:
+public:
+	NullRenderer();
+	virtual ~NullRenderer();
+
+	// windowed is ignored; the size is the canvas gameplay lays itself out in
+	virtual bool Initialize(bool windowed, int width = 0, int height = 0);
+
+	virtual void Clear();
+	virtual void Present();
+
+	virtual void GetCanvasPlacement(float& x, float& y, float& scale) const;
+
+	virtual void DrawSprite(Sprite& sprite, bool FlipHorizontal = false);
+	virtual void DrawAnimatedSprite(AnimatedSprite& sprite, int frame, bool FlipHorizontal = false);
+
+	virtual void DrawFilledRect(float x1, float y1, float x2, float y2, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+	virtual void DrawOutlinedRect(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+	virtual void DrawLine(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+
+	// Keyed like the GL ones, so gameplay only re-records a layer's content when it really changed
+	virtual int AcquireCachedLayer();
+	virtual void ReleaseCachedLayer(int cachedLayer);
+	virtual bool BeginCachedLayer(int cachedLayer, unsigned int contentKey);
+	virtual void EndCachedLayer();
+	virtual void DrawCachedLayer(int cachedLayer);
+
+	// Nothing is rendered, so there is nothing to capture
+	virtual void CaptureScreenshot(const char* pcFilename);
+	virtual void StartRecording(const char* pcFilename, int framesPerSecond = 60);
+	virtual void StopRecording();
+	virtual bool IsRecording() const;
+
+	virtual GpuTimer* GetGpuTimer();
+
+	// Always zero, nothing reaches a GPU
+	virtual void GetFrameStats(RenderStats& stats);
+
+protected:
+
+private:
+	NullRenderer(const NullRenderer& renderer);
+	NullRenderer& operator=(const NullRenderer& renderer);
+
+	// Member data:
+public:
+
+protected:
+	struct CachedLayer
+	{
+		unsigned int contentKey;
+		bool bInUse;
+		bool bValid;
+	};
+
+	std::vector<CachedLayer> m_cachedLayers;
+
+private:
+
+};
+
+#endif // __NULLRENDERER_H_
@@ -0,0 +1,53 @@
+// COMP710 GP Framework 2025
+#ifndef __PALETTEATLAS_H_
+#define __PALETTEATLAS_H_
+
+// Library includes:
+#include <vector>
+
+// Every palette used by indexed textures, one 256 entry RGBA8 row each, in a single texture
+// that the sprite shaders look colours up in. A sprite picks its row per instance, so recoloured
+// variants (elite enemies, boss phases) are a new row rather than a new sheet, and still batch.
+class PaletteAtlas
+{
+	// Member methods:
+public:
+	PaletteAtlas();
+	~PaletteAtlas();
+
+	bool Initialise();
+
+	// Returns the new row, or NO_PALETTE when the atlas is full
+	unsigned int AddPalette(const std::vector<unsigned int>& colours);
+	bool IsFull() const;
+
+	unsigned int GetTextureId() const;
+
+	// RGBA32 pixels to indices, colours added to the palette in the order they are first met.
+	// Fails once a 257th colour turns up. Fully transparent pixels all share one entry.
+	static bool IndexPixels(const unsigned char* pPixels, int width, int height, int pitch
+		, std::vector<unsigned int>& palette, std::vector<unsigned char>& indices);
+
+protected:
+
+private:
+	PaletteAtlas(const PaletteAtlas& paletteAtlas);
+	PaletteAtlas& operator=(const PaletteAtlas& paletteAtlas);
+
+	// Member data:
+public:
+	static const unsigned int PALETTE_SIZE = 256;
+	static const unsigned int MAX_PALETTES = 256;
+
+	// Matches the 0xFFFF the sprite shaders read as "not indexed"
+	static const unsigned int NO_PALETTE = 0xFFFF;
+
+protected:
+	unsigned int m_uiTextureId;
+	unsigned int m_numPalettes;
+
+private:
+
+};
+
+#endif // __PALETTEATLAS_H_
@@ -19,15 +19,26 @@ PlayerHUD::PlayerHUD(Renderer* renderer, Player* player)
     , m_pEssenceTextSprite(nullptr)
     , m_pEssenceTextTexture(nullptr)
     , m_lastEssenceStr("")
+    , m_iChromeCachedLayer(-1)
 {
     if (!m_pRenderer || !m_pPlayer) 
     {
         LogManager::GetInstance().Log("PlayerHUD critical error: Null pointer in constructor.");
     }
+
+    if (m_pRenderer)
+    {
+        m_iChromeCachedLayer = m_pRenderer->AcquireCachedLayer();
+    }
 }
 
 PlayerHUD::~PlayerHUD()
 {
+    if (m_pRenderer)
+    {
+        m_pRenderer->ReleaseCachedLayer(m_iChromeCachedLayer);
+    }
+
     delete m_pEssenceTextSprite; m_pEssenceTextSprite = nullptr;
     delete m_pEssenceTextTexture; m_pEssenceTextTexture = nullptr;
 }
@@ -42,67 +53,13 @@ void PlayerHUD::Draw()
     // Calculate total width of the UI group (Health + Space + Stamina) to center it
     float groupStartX = (static_cast<float>(screenWidth) - totalBarGroupWidth) / 2.0f;
 
-    // --- Health Bar ---
     float healthBarX = groupStartX;
     float healthBarY = static_cast<float>(screenHeight) - BAR_Y_OFFSET_FROM_BOTTOM - BAR_HEIGHT;
 
-    int currentHealth = m_pPlayer->GetCurrentHealth();
-    int maxHealth = m_pPlayer->GetPlayerStats().GetMaxHealth();
-    float healthRatio = (maxHealth > 0) ? static_cast<float>(currentHealth) / static_cast<float>(maxHealth) : 0.0f;
-    healthRatio = std::max(0.0f, std::min(1.0f, healthRatio));
-
-    // Health Bar Border
-    m_pRenderer->DrawDebugRect(healthBarX - BORDER_THICKNESS, healthBarY - BORDER_THICKNESS,
-        healthBarX + HEALTH_BAR_WIDTH + BORDER_THICKNESS,
-        healthBarY + BAR_HEIGHT + BORDER_THICKNESS,
-        BAR_BORDER_R, BAR_BORDER_G, BAR_BORDER_B, BAR_BORDER_A);
-
-    // Health Bar Background
-    m_pRenderer->DrawDebugRect(healthBarX, healthBarY,
-        healthBarX + HEALTH_BAR_WIDTH,
-        healthBarY + BAR_HEIGHT,
-        BAR_BG_R, BAR_BG_G, BAR_BG_B, BAR_BG_A);
-
-    // Health Bar Fill
-    if (healthRatio > 0)
-    {
-        m_pRenderer->DrawDebugRect(healthBarX, healthBarY,
-            healthBarX + (HEALTH_BAR_WIDTH * healthRatio),
-            healthBarY + BAR_HEIGHT,
-            HEALTH_FILL_R, HEALTH_FILL_G, HEALTH_FILL_B, BAR_FILL_A);
-    }
-
-    // --- Stamina Bar ---
     float staminaBarX = healthBarX + HEALTH_BAR_WIDTH + BAR_SPACING;
     float staminaBarY = healthBarY;
 
-    float currentStamina = m_pPlayer->GetCurrentStamina();
-    float maxStamina = m_pPlayer->GetPlayerStats().GetMaxStamina();
-    float staminaRatio = (maxStamina > 0.0f) ? currentStamina / maxStamina : 0.0f;
-    staminaRatio = std::max(0.0f, std::min(1.0f, staminaRatio));
-
-    // Stamina Bar Border
-    m_pRenderer->DrawDebugRect(staminaBarX - BORDER_THICKNESS, staminaBarY - BORDER_THICKNESS,
-        staminaBarX + STAMINA_BAR_WIDTH + BORDER_THICKNESS,
-        staminaBarY + BAR_HEIGHT + BORDER_THICKNESS,
-        BAR_BORDER_R, BAR_BORDER_G, BAR_BORDER_B, BAR_BORDER_A);
-
-    // Stamina Bar Background
-    m_pRenderer->DrawDebugRect(staminaBarX, staminaBarY,
-        staminaBarX + STAMINA_BAR_WIDTH,
-        staminaBarY + BAR_HEIGHT,
-        BAR_BG_R, BAR_BG_G, BAR_BG_B, BAR_BG_A);
-
-    // Stamina Bar Fill
-    if (staminaRatio > 0)
-    {
-        m_pRenderer->DrawDebugRect(staminaBarX, staminaBarY,
-            staminaBarX + (STAMINA_BAR_WIDTH * staminaRatio),
-            staminaBarY + BAR_HEIGHT,
-            STAMINA_FILL_R, STAMINA_FILL_G, STAMINA_FILL_B, BAR_FILL_A);
-    }
-
-    // --- Abyssal Essence Display ---
+    // --- Abyssal Essence Text ---
     std::string currentEssenceStr = "Essence: " + std::to_string(m_pPlayer->GetAbyssalEssence().GetCurrentAmount());
     if (m_lastEssenceStr != currentEssenceStr || !m_pEssenceTextSprite) 
     {
@@ -127,23 +84,86 @@ void PlayerHUD::Draw()
         }
     }
 
-    if (m_pEssenceTextSprite) 
+    // Positioned next to stam bar, sized to the text
+    float essencePanelWidth = m_pEssenceTextSprite ? static_cast<float>(m_pEssenceTextTexture->GetWidth()) + 20.0f : 0.0f;
+    float essencePanelHeight = BAR_HEIGHT;
+    float essencePanelX = staminaBarX + STAMINA_BAR_WIDTH + BAR_SPACING;
+    float essencePanelY = healthBarY;
+
+    // --- Chrome: borders and backgrounds, only re-rendered when the essence panel changes width ---
+    if (m_pRenderer->BeginCachedLayer(m_iChromeCachedLayer, static_cast<unsigned int>(essencePanelWidth)))
     {
-        float essenceTextWidth = static_cast<float>(m_pEssenceTextTexture->GetWidth());
-        float essencePanelWidth = essenceTextWidth + 20.0f;
-        float essencePanelHeight = BAR_HEIGHT;
-        // Positioned next to stam bar
-        float essencePanelX = staminaBarX + STAMINA_BAR_WIDTH + BAR_SPACING;
-        float essencePanelY = healthBarY;
-
-        // Essence Border
-        m_pRenderer->DrawDebugRect(essencePanelX, essencePanelY, essencePanelX + essencePanelWidth, essencePanelY + essencePanelHeight,
+        // Health Bar Border
+        m_pRenderer->DrawFilledRect(healthBarX - BORDER_THICKNESS, healthBarY - BORDER_THICKNESS,
+            healthBarX + HEALTH_BAR_WIDTH + BORDER_THICKNESS,
+            healthBarY + BAR_HEIGHT + BORDER_THICKNESS,
+            BAR_BORDER_R, BAR_BORDER_G, BAR_BORDER_B, BAR_BORDER_A);
+
+        // Health Bar Background
+        m_pRenderer->DrawFilledRect(healthBarX, healthBarY,
+            healthBarX + HEALTH_BAR_WIDTH,
+            healthBarY + BAR_HEIGHT,
             BAR_BG_R, BAR_BG_G, BAR_BG_B, BAR_BG_A);
 
-        // Essence Background
-        m_pRenderer->DrawDebugRect(essencePanelX - BORDER_THICKNESS, essencePanelY - BORDER_THICKNESS, essencePanelX + essencePanelWidth + BORDER_THICKNESS, essencePanelY + essencePanelHeight + BORDER_THICKNESS,
+        // Stamina Bar Border
+        m_pRenderer->DrawFilledRect(staminaBarX - BORDER_THICKNESS, staminaBarY - BORDER_THICKNESS,
+            staminaBarX + STAMINA_BAR_WIDTH + BORDER_THICKNESS,
+            staminaBarY + BAR_HEIGHT + BORDER_THICKNESS,
             BAR_BORDER_R, BAR_BORDER_G, BAR_BORDER_B, BAR_BORDER_A);
 
+        // Stamina Bar Background
+        m_pRenderer->DrawFilledRect(staminaBarX, staminaBarY,
+            staminaBarX + STAMINA_BAR_WIDTH,
+            staminaBarY + BAR_HEIGHT,
+            BAR_BG_R, BAR_BG_G, BAR_BG_B, BAR_BG_A);
+
+        if (m_pEssenceTextSprite)
+        {
+            // Essence Border
+            m_pRenderer->DrawFilledRect(essencePanelX, essencePanelY, essencePanelX + essencePanelWidth, essencePanelY + essencePanelHeight,
+                BAR_BG_R, BAR_BG_G, BAR_BG_B, BAR_BG_A);
+
+            // Essence Background
+            m_pRenderer->DrawFilledRect(essencePanelX - BORDER_THICKNESS, essencePanelY - BORDER_THICKNESS, essencePanelX + essencePanelWidth + BORDER_THICKNESS, essencePanelY + essencePanelHeight + BORDER_THICKNESS,
+                BAR_BORDER_R, BAR_BORDER_G, BAR_BORDER_B, BAR_BORDER_A);
+        }
+
+        m_pRenderer->EndCachedLayer();
+    }
+
+    m_pRenderer->DrawCachedLayer(m_iChromeCachedLayer);
+
+    // --- Health Bar Fill ---
+    int currentHealth = m_pPlayer->GetCurrentHealth();
+    int maxHealth = m_pPlayer->GetPlayerStats().GetMaxHealth();
+    float healthRatio = (maxHealth > 0) ? static_cast<float>(currentHealth) / static_cast<float>(maxHealth) : 0.0f;
+    healthRatio = std::max(0.0f, std::min(1.0f, healthRatio));
+
+    if (healthRatio > 0)
+    {
+        m_pRenderer->DrawFilledRect(healthBarX, healthBarY,
+            healthBarX + (HEALTH_BAR_WIDTH * healthRatio),
+            healthBarY + BAR_HEIGHT,
+            HEALTH_FILL_R, HEALTH_FILL_G, HEALTH_FILL_B, BAR_FILL_A);
+    }
+
+    // --- Stamina Bar Fill ---
+    float currentStamina = m_pPlayer->GetCurrentStamina();
+    float maxStamina = m_pPlayer->GetPlayerStats().GetMaxStamina();
+    float staminaRatio = (maxStamina > 0.0f) ? currentStamina / maxStamina : 0.0f;
+    staminaRatio = std::max(0.0f, std::min(1.0f, staminaRatio));
+
+    if (staminaRatio > 0)
+    {
+        m_pRenderer->DrawFilledRect(staminaBarX, staminaBarY,
+            staminaBarX + (STAMINA_BAR_WIDTH * staminaRatio),
+            staminaBarY + BAR_HEIGHT,
+            STAMINA_FILL_R, STAMINA_FILL_G, STAMINA_FILL_B, BAR_FILL_A);
+    }
+
+    // --- Abyssal Essence Display ---
+    if (m_pEssenceTextSprite) 
+    {
         m_pEssenceTextSprite->SetX(static_cast<int>(essencePanelX + essencePanelWidth / 2));
         m_pEssenceTextSprite->SetY(static_cast<int>(essencePanelY + essencePanelHeight / 2));
         m_pEssenceTextSprite->Draw(*m_pRenderer);
@@ -38,6 +38,9 @@ private:
     Texture* m_pEssenceTextTexture;
     std::string m_lastEssenceStr;
 
+    // Bar borders, bar backgrounds and the essence panel
+    int m_iChromeCachedLayer;
+
     const char* m_uiFontPath = "assets/fonts/OptimusPrinceps.ttf";
     const int m_uiFontSize = 16;
 
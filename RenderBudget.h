@@ -0,0 +1,63 @@
+// COMP710 GP Framework 2025
+#ifndef __RENDERBUDGET_H_
+#define __RENDERBUDGET_H_
+
+// Local includes:
+#include "RenderStats.h"
+
+// Library includes:
+#include <string>
+#include <vector>
+
+// Upper limits on a frame's RenderStats, checked by automated runs so a change that costs more
+// draws or uploads fails instead of slipping in. Limits are named after the stats:
+// draw_calls, triangles, program_switches, texture_binds, uniform_uploads, bytes_uploaded,
+// texture_uploads, texture_bytes_uploaded, text_uploads, text_bytes_uploaded, and per pass
+// clear_draw_calls ... present_draw_calls.
+class RenderBudget
+{
+	// Member methods:
+public:
+	RenderBudget();
+	~RenderBudget();
+
+	// "name limit" per line. Blank lines and lines starting with '#' are skipped.
+	// warmup_frames is not a limit: frames before it are loading and aren't checked.
+	bool Load(const char* pcFilename);
+	bool SetLimit(const std::string& name, unsigned int limit);
+
+	int GetWarmupFrames() const;
+	bool IsEmpty() const;
+
+	// Appends a line to failures for each limit the frame goes over
+	bool Check(const RenderStats& stats, int frame, std::string& failures) const;
+
+	// Every name a limit can be set on, in the order the harness reports them
+	static void GetStatNames(std::vector<std::string>& names);
+	static bool GetStat(const RenderStats& stats, const std::string& name, unsigned int& value);
+
+protected:
+	static std::string GetPassStatName(GpuPass pass);
+
+private:
+	RenderBudget(const RenderBudget& renderBudget);
+	RenderBudget& operator=(const RenderBudget& renderBudget);
+
+	// Member data:
+public:
+
+protected:
+	struct Limit
+	{
+		std::string name;
+		unsigned int limit;
+	};
+
+	std::vector<Limit> m_limits;
+	int m_iWarmupFrames;
+
+private:
+
+};
+
+#endif // __RENDERBUDGET_H_
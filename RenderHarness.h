@@ -0,0 +1,96 @@
+// COMP710 GP Framework 2025
+#ifndef __RENDERHARNESS_H_
+#define __RENDERHARNESS_H_
+
+// Local includes:
+#include "RenderBudget.h"
+
+// Library includes:
+#include <string>
+#include <vector>
+
+// Offscreen regression and benchmark run of the real GL path, run the game with
+// -renderharness [-update] from the game directory. SceneAbyssWalker is played at a fixed step
+// into a hidden window, the frames listed in assets/golden/script.txt are captured from the canvas
+// and compared with the golden images beside it, every frame is checked against the RenderBudget
+// in assets/golden/budget.txt, and frame times and draw calls are reported.
+// Build machines without a GPU can run it on a software GL such as Mesa's llvmpipe.
+class RenderHarness
+{
+	// Member methods:
+public:
+	RenderHarness();
+	~RenderHarness();
+
+	// One frame number per line, counted from 1. Blank lines and lines starting with '#' are skipped.
+	bool LoadScript(const char* pcScriptFilename);
+	bool LoadBudget(const char* pcBudgetFilename);
+
+	// Plays up to the last scripted frame, saving each scripted frame as frame_NNNN.png
+	// and checking each frame's RenderStats against the budget
+	bool Run(const char* pcCaptureDirectory);
+
+	// Returns how many captures are missing or differ from their golden image. Frames with no
+	// golden image yet are counted apart and reported, but don't fail the run.
+	int Compare(const char* pcCaptureDirectory, const char* pcGoldenDirectory);
+
+	bool WriteReport(const char* pcFilename) const;
+
+	static int RunBuildStep(bool updateGolden);
+
+protected:
+	static std::string GetFramePath(const char* pcDirectory, int frame);
+
+	// Loaded as RGBA8, so the hash and diff don't depend on how the PNG was encoded
+	static bool LoadPixels(const std::string& path, int& width, int& height, std::vector<unsigned char>& pixels);
+	static unsigned long long HashPixels(const std::vector<unsigned char>& pixels);
+
+private:
+	RenderHarness(const RenderHarness& renderHarness);
+	RenderHarness& operator=(const RenderHarness& renderHarness);
+
+	// Member data:
+public:
+
+protected:
+	struct FrameResult
+	{
+		int frame;
+		unsigned long long hash;
+		unsigned long long goldenHash;
+		int differingPixels;
+		bool bCaptured;
+		bool bHasGolden;
+		bool bMatch;
+	};
+
+	// A channel may be this far off before the pixel counts as different: GPUs and software
+	// rasterisers round blending and filtering slightly differently
+	static const int CHANNEL_TOLERANCE = 8;
+
+	// Differing pixels allowed per million before a frame fails
+	static const int MAX_DIFFERING_PIXELS_PER_MILLION = 1000;
+
+	std::vector<int> m_scriptedFrames;
+	std::vector<FrameResult> m_results;
+	int m_iMissingGoldens;
+
+	RenderBudget m_budget;
+	RenderStats m_peakStats;
+	int m_iFramesOverBudget;
+	std::string m_budgetFailures;
+
+	int m_iFramesRun;
+	float m_fWallSeconds;
+	float m_fGameTimeTotal;
+	float m_fGameTimeMax;
+	float m_fRenderTimeTotal;
+	float m_fRenderTimeMax;
+	long long m_iDrawCallsTotal;
+	int m_iDrawCallsMax;
+
+private:
+
+};
+
+#endif // __RENDERHARNESS_H_
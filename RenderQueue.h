@@ -0,0 +1,114 @@
+// COMP710 GP Framework 2025
+#ifndef __RENDERQUEUE_H_
+#define __RENDERQUEUE_H_
+
+// Local includes:
+#include "SpriteBatch.h"
+
+// Library includes:
+#include <vector>
+#include <cstdint>
+
+// Draw layers, back to front. The layer is the most significant part of the sort key,
+// so it alone decides what is drawn over what. IMGUI is drawn by ImGui after the queue.
+enum class RenderLayer : unsigned char
+{
+	BACKGROUND,
+	WORLD,
+	FX,
+	HUD,
+	MENU,
+	IMGUI
+};
+
+// Program used by a command. Within a layer cached content sorts first, then shapes,
+// so panels sit under their text. COMPOSITE is the sprite program with premultiplied blending,
+// SPRITE_ARRAY the sprite program sampling texture arrays.
+enum class RenderProgram : unsigned char
+{
+	COMPOSITE,
+	SHAPE,
+	SPRITE,
+	SPRITE_ARRAY
+};
+
+enum class ShapeType : unsigned char
+{
+	FILLED_RECT,
+	OUTLINED_RECT,
+	LINE
+};
+
+struct ShapeCommand
+{
+	ShapeType type;
+	float x1;
+	float y1;
+	float x2;
+	float y2;
+	float thickness;
+	unsigned char r;
+	unsigned char g;
+	unsigned char b;
+	unsigned char a;
+};
+
+struct RenderCommand
+{
+	RenderProgram program;
+	unsigned int textureId; // 0 for shapes
+	union
+	{
+		SpriteInstance sprite;
+		ShapeCommand shape;
+	};
+};
+
+// Collects a frame's draw commands and orders them by a 64-bit key:
+// layer (8 bits) | program (8 bits) | texture (16 bits) | submission order (32 bits).
+// The radix sort is stable, so commands with equal keys keep the order they were pushed in.
+class RenderQueue
+{
+	// Member methods:
+public:
+	RenderQueue();
+	~RenderQueue();
+
+	void Push(RenderLayer layer, const RenderCommand& command);
+	void Sort();
+	void Clear();
+
+	unsigned int GetCount() const;
+	const RenderCommand& GetSorted(unsigned int index) const;
+	RenderLayer GetSortedLayer(unsigned int index) const;
+
+	static uint64_t MakeSortKey(RenderLayer layer, RenderProgram program, unsigned int textureId, unsigned int order);
+
+protected:
+
+private:
+	RenderQueue(const RenderQueue& renderQueue);
+	RenderQueue& operator=(const RenderQueue& renderQueue);
+
+	// Member data:
+public:
+
+protected:
+	struct SortEntry
+	{
+		uint64_t key;
+		unsigned int commandIndex;
+	};
+
+	std::vector<RenderCommand> m_commands;
+	std::vector<SortEntry> m_entries;
+	std::vector<SortEntry> m_scratch;
+
+	unsigned int m_nextOrder;
+	bool m_bSorted;
+
+private:
+
+};
+
+#endif // __RENDERQUEUE_H_
@@ -0,0 +1,43 @@
+// COMP710 GP Framework 2025
+#ifndef __RENDERSTATS_H_
+#define __RENDERSTATS_H_
+
+// Local includes:
+#include "GpuTimer.h"
+
+// What one frame asked of GL, counted where the calls are made and reset each frame. Each thread
+// counts into its own GLStateCache, the render thread's frame adds what the game thread uploaded
+// while recording it. ImGui's own draws are not counted.
+struct RenderStats
+{
+	int drawCalls;
+	int triangles;
+	int programSwitches;
+	int textureBinds;
+	int uniformUploads;
+	unsigned int bytesUploaded; // Vertices, sprite instances and uniform buffers
+
+	int textureUploads;
+	unsigned int textureBytesUploaded;
+
+	// Text re-rasterised into its texture when it changes, kept out of textureUploads so a steady
+	// state with no texture uploads can still have a HUD counter ticking over
+	int textUploads;
+	unsigned int textBytesUploaded;
+
+	// Draw calls made in each pass; cached layers being re-recorded count towards CLEAR
+	int passDrawCalls[GpuTimer::PASS_COUNT];
+
+	// Render thread time spent issuing the frame, up to the swap
+	float cpuMilliseconds;
+
+	RenderStats();
+
+	void Reset();
+	void Add(const RenderStats& stats);
+	void Max(const RenderStats& stats); // Keeps the larger of each count, for the worst frame of a run
+	void AddTextureUpload(unsigned int bytes);
+	void AddTextUpload(unsigned int bytes);
+};
+
+#endif // __RENDERSTATS_H_
@@ -0,0 +1,120 @@
+// COMP710 GP Framework 2025
+#ifndef __RENDERTHREAD_H_
+#define __RENDERTHREAD_H_
+
+// Local includes:
+#include "Renderer.h"
+#include "RenderQueue.h"
+#include "Matrix4.h"
+#include "RenderStats.h"
+#include "imgui/imgui.h"
+
+// Library includes:
+#include <SDL.h>
+#include <glew.h>
+#include <string>
+#include <vector>
+
+// Forward Declarations:
+class GLRenderer;
+
+// Everything the render thread needs to draw one frame, recorded by the game thread.
+struct RenderFrame
+{
+	static const int MAX_CACHED_LAYERS = 4;
+
+	RenderQueue queue;
+
+	// Cached layers whose content was re-recorded this frame, rendered before the frame itself
+	bool cachedLayerDirty[MAX_CACHED_LAYERS];
+	unsigned int cachedLayerTextures[MAX_CACHED_LAYERS];
+	RenderQueue cachedLayerQueues[MAX_CACHED_LAYERS];
+
+	float clearRed;
+	float clearGreen;
+	float clearBlue;
+
+	VsyncMode vsyncMode; // Applied before this frame's swap
+
+	Matrix4 cameraViewProj;
+
+	// Captured once this frame is drawn, empty when no screenshot was asked for
+	std::string screenshotPath;
+
+	// Deep copy, ImGui reuses its own draw lists as soon as the next frame starts
+	ImDrawData imguiDrawData;
+
+	// Textures released while this frame was recorded, deleted once it has been drawn
+	std::vector<unsigned int> textureDeletes;
+
+	// Signalled by the game thread's context once this frame's texture uploads are complete
+	GLsync uploadFence;
+
+	// What the game thread uploaded while recording this frame
+	RenderStats uploadStats;
+};
+
+// Owns the render thread and the two frames it ping-pongs with the game thread: the game thread
+// records frame N+1 while the render thread replays frame N into the window's GL context.
+// The game thread keeps a second, shared context so textures can still be created while playing.
+class RenderThread
+{
+	// Member methods:
+public:
+	static RenderThread& GetInstance();
+	static void DestroyInstance();
+
+	bool Start(GLRenderer* pRenderer, SDL_Window* pWindow, SDL_GLContext renderContext);
+	void Stop();
+	bool IsRunning() const;
+
+	// Game thread:
+	RenderFrame& GetRecordFrame();
+	void Submit(const ImDrawData* pImguiDrawData);
+
+	void OnTextureUploaded();
+	void DeleteTexture(unsigned int textureId);
+
+protected:
+	static int RenderThreadMain(void* pData);
+	void Run();
+
+	void DeleteTextures(std::vector<unsigned int>& textureIds);
+	static void CopyDrawData(ImDrawData& destination, const ImDrawData* pSource);
+	static void FreeDrawData(ImDrawData& drawData);
+
+private:
+	RenderThread();
+	~RenderThread();
+	RenderThread(const RenderThread& renderThread);
+	RenderThread& operator=(const RenderThread& renderThread);
+
+	// Member data:
+public:
+
+protected:
+	static RenderThread* sm_pInstance;
+
+	GLRenderer* m_pRenderer;
+	SDL_Window* m_pWindow;
+	SDL_GLContext m_renderContext;
+	SDL_GLContext m_loaderContext;
+
+	SDL_Thread* m_pThread;
+	SDL_mutex* m_pMutex;
+	SDL_cond* m_pFrameReady;
+	SDL_cond* m_pFrameDone;
+
+	RenderFrame m_frames[2];
+	int m_iRecordFrame;
+
+	RenderFrame* m_pPendingFrame;
+	bool m_bQuit;
+	bool m_bRunning;
+	bool m_bTexturesUploaded;
+
+private:
+
+};
+
+#endif // __RENDERTHREAD_H_
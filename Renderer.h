@@ -4,56 +4,102 @@
 
 // Forward Declarations:
 class TextureManager;
-class Shader;
-class VertexArray;
 class Sprite;
-struct SDL_Window;
 class AnimatedSprite;
+class Camera2D;
+class GpuTimer;
+struct RenderStats;
 
+// Local includes:
+#include "RenderQueue.h"
 
 // Library includes:
 #include <SDL.h>
-#include <glew.h>
 
+// How buffer swaps wait for the display. ADAPTIVE waits like ON, but a frame that misses the
+// refresh is shown straight away (with a tear) rather than held a whole extra refresh.
+enum class VsyncMode
+{
+	OFF,
+	ON,
+	ADAPTIVE
+};
+
+// Everything gameplay draws through. GLRenderer draws with OpenGL; NullRenderer keeps textures
+// and sprites at their real sizes but never touches GL, so the game can run without a GPU.
 class Renderer
 {
 	// Member methods:
 public:
 	Renderer();
-	~Renderer();
+	virtual ~Renderer();
 
-	bool Initialize(bool windowed, int width = 0, int height = 0);
+	// Optional, before Initialize: draw into a fixed size canvas that is scaled up to the window
+	// by whole multiples and letterboxed. GetWidth/GetHeight then report the canvas size.
+	void SetInternalResolution(int width, int height);
+	virtual bool Initialize(bool windowed, int width = 0, int height = 0) = 0;
 
-	void Clear();
-	void Present();
+	// Clear starts recording a frame and Present hands it over to be drawn
+	virtual void Clear() = 0;
+	virtual void Present() = 0;
 
 	void SetClearColor(unsigned char r, unsigned char g, unsigned char b);
 	void GetClearColor(unsigned char& r, unsigned char& g, unsigned char& b);
 
+	// Taken up from the next frame, OFF until set. Backends without a display ignore it.
+	void SetVsyncMode(VsyncMode mode);
+	VsyncMode GetVsyncMode() const;
+
 	int GetWidth() const;
 	int GetHeight() const;
 
+	// Where the canvas sits in the window, for mapping window coordinates such as the mouse
+	virtual void GetCanvasPlacement(float& x, float& y, float& scale) const = 0;
+
 	// Draw Static Sprites
 	Sprite* CreateSprite(const char* pcFilename);
-	void DrawSprite(Sprite& sprite, bool FlipHorizontal = false);
+	virtual void DrawSprite(Sprite& sprite, bool FlipHorizontal = false) = 0;
 
 	// Draw Animated Sprites
 	AnimatedSprite* CreateAnimatedSprite(const char* pcFilename);
-	void DrawAnimatedSprite(AnimatedSprite& sprite, int frame, bool FlipHorizontal = false);
+	virtual void DrawAnimatedSprite(AnimatedSprite& sprite, int frame, bool FlipHorizontal = false) = 0;
 
 	void CreateStaticText(const char* pText, int pointsize);
 
+	// Shapes (UI panels, bars, debug)
 	void DrawDebugRect(float x1, float y1, float x2, float y2, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+	virtual void DrawFilledRect(float x1, float y1, float x2, float y2, unsigned char r, unsigned char g, unsigned char b, unsigned char a) = 0;
+	virtual void DrawOutlinedRect(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a) = 0;
+	virtual void DrawLine(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a) = 0;
+
+	// Cached layers: static screen space content recorded once into an offscreen texture, then
+	// composited with one quad underneath the rest of the current layer. BeginCachedLayer returns
+	// true when the content key or the canvas size changed; draw the content and call EndCachedLayer.
+	virtual int AcquireCachedLayer() = 0;
+	virtual void ReleaseCachedLayer(int cachedLayer) = 0;
+	virtual bool BeginCachedLayer(int cachedLayer, unsigned int contentKey) = 0;
+	virtual void EndCachedLayer() = 0;
+	virtual void DrawCachedLayer(int cachedLayer) = 0;
+
+	// Draws are queued under the current layer and sorted by layer, program, texture and order
+	// in Present, so the order gameplay code submits in doesn't decide layering. Reset to WORLD each Clear.
+	void SetLayer(RenderLayer layer);
+	RenderLayer GetLayer() const;
+
+	// Asynchronous capture of the canvas (or window) without the ImGui overlay. Files are written
+	// a couple of frames later by a writer thread: a PNG, or an uncompressed Y4M video stream.
+	virtual void CaptureScreenshot(const char* pcFilename) = 0;
+	virtual void StartRecording(const char* pcFilename, int framesPerSecond = 60) = 0;
+	virtual void StopRecording() = 0;
+	virtual bool IsRecording() const = 0;
+
+	// GPU time per render pass, for the debug window. 0 when the backend can't time the GPU.
+	virtual GpuTimer* GetGpuTimer() = 0;
+
+	// Counts for the last frame drawn (see RenderStats), a frame behind the one being recorded
+	virtual void GetFrameStats(RenderStats& stats) = 0;
 
 protected:
-	bool InitializeOpenGL(int screenWidth, int screenHeight);
-	void SetFullscreen(bool fullscreen);
-
-	void LogSdlError();
-
-	bool SetupSpriteShader();
-
-	GLuint m_whitePixelTextureID;
 
 private:
 	Renderer(const Renderer& renderer);
@@ -63,23 +109,31 @@ private:
 public:
 	TextureManager* GetTextureManager() { return m_pTextureManager; }
 
+	// Views the WORLD and FX layers, sprites outside it are culled as they are queued.
+	// BACKGROUND, HUD and MENU stay in screen space.
+	Camera2D* GetCamera() { return m_pCamera; }
+
 protected:
+	// Created by Initialize and deleted by the backend, while it can still release their resources
 	TextureManager* m_pTextureManager;
-	SDL_Window* m_pWindow;
-	SDL_GLContext m_glContext;
+	Camera2D* m_pCamera;
 
-	Shader* m_pSpriteShader;
-	VertexArray* m_pSpriteVertexData;
+	RenderLayer m_currentLayer;
 
 	int m_iWidth;
 	int m_iHeight;
 
+	int m_iInternalWidth;
+	int m_iInternalHeight;
+
 	float m_fClearRed;
 	float m_fClearGreen;
 	float m_fClearBlue;
 
+	VsyncMode m_vsyncMode;
+
 private:
 
 };
 
-#endif // __RENDERER_H_
\ No newline at end of file
+#endif // __RENDERER_H_
@@ -278,14 +278,13 @@ void SceneTitleScreen::Process(float deltaTime, InputSystem& inputSystem)
 
 void SceneTitleScreen::Draw(Renderer& renderer)
 {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
+    renderer.SetLayer(RenderLayer::BACKGROUND);
     if (m_pTitleScreenImageSprite && m_pTitleScreenImageTexture && m_pTitleScreenImageTexture->GetWidth() > 0)
     {
         m_pTitleScreenImageSprite->Draw(renderer);
     }
     
+    renderer.SetLayer(RenderLayer::MENU);
     for (const auto& btn : m_allButtons)
     {
         if (btn.textSprite)
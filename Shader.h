@@ -4,6 +4,10 @@
 
 #include "glew.h"
 
+// Library includes:
+#include <map>
+#include <string>
+
 // Forward declarations:
 struct Matrix4;
 
@@ -14,21 +18,48 @@ public:
 	Shader();
 	~Shader();
 
+	// Reuses the program binary cached by a previous run when the sources and driver are unchanged
 	bool Load(const char* vertexFile, const char* pixelFile);
 	void Unload();
 
+	// Relinks from the files if either changed since the last load. An edit that fails to compile
+	// keeps the current program. Returns true when relinked: uniforms and block bindings are reset.
+	bool ReloadIfChanged();
+
 	void SetActive();
 
+	// Locations are resolved once at link time, look a handle up once and keep it for hot paths
+	GLint GetUniformLocation(const char* name) const;
+	void BindUniformBlock(const char* blockName, GLuint bindingPoint);
+
 	void SetMatrixUniform(const char* name, const Matrix4& matrix);
+	void SetMatrixUniform(GLint location, const Matrix4& matrix);
 	void SetVector4Uniform(const char* name, float x, float y, float z, float w);
+	void SetVector4Uniform(GLint location, float x, float y, float z, float w);
+	void SetIntegerUniform(const char* name, int value);
+	void SetIntegerUniform(GLint location, int value);
 
 protected:
 
 private:
-	bool IsValidProgram();
+	void CacheUniformLocations();
+	void ReplaceProgram(GLuint program, GLuint vertexShader, GLuint pixelShader);
+
+	bool LoadProgramBinary(unsigned long long key);
+	void SaveProgramBinary(unsigned long long key) const;
+	std::string GetBinaryCacheFile() const;
+	static const std::string& GetBinaryCacheDirectory();
+	static std::string GetFileName(const std::string& path);
+	unsigned long long GetBinaryKey() const;
 
-	static bool CompileShader(const char* filename, GLenum shaderType, GLuint& outShader);
+	static bool ReadSource(const char* filename, std::string& source);
+	static bool BuildProgram(const std::string& vertexSource, const std::string& pixelSource, GLuint& outProgram, GLuint& outVertexShader, GLuint& outPixelShader);
+	static bool CompileShader(const std::string& source, GLenum shaderType, GLuint& outShader);
 	static bool IsCompiled(GLuint shader);
+	static bool IsLinked(GLuint program);
+
+	static unsigned long long HashString(const std::string& text, unsigned long long hash);
+	static bool IsProgramBinarySupported();
 
 	// Member data:
 public:
@@ -38,6 +69,15 @@ protected:
 	GLuint m_pixelShader;
 	GLuint m_shaderProgram;
 
+	std::string m_vertexFile;
+	std::string m_pixelFile;
+	unsigned long long m_sourceHash; // Of both files as last loaded, or last tried
+
+	static const char BINARY_CACHE_MAGIC[4];
+	static const unsigned long long HASH_SEED = 14695981039346656037ULL; // FNV-1a
+
+	std::map<std::string, GLint> m_uniformLocations;
+
 private:
 
 };
@@ -0,0 +1,65 @@
+// COMP710 GP Framework 2025
+#ifndef __SHAPEBATCH_H_
+#define __SHAPEBATCH_H_
+
+// Library includes:
+#include <vector>
+
+// Forward Declarations:
+class StreamingBuffer;
+
+struct ShapeVertex
+{
+	float x;
+	float y;
+	unsigned char r;
+	unsigned char g;
+	unsigned char b;
+	unsigned char a;
+};
+
+// Untextured, per-vertex coloured triangles for UI panels, bars and debug shapes.
+// Everything added between flushes goes out in one draw call, unless it outgrows one upload.
+class ShapeBatch
+{
+	// Member methods:
+public:
+	ShapeBatch();
+	~ShapeBatch();
+
+	bool Initialise(unsigned int verticesPerUpload);
+
+	void AddFilledRect(float x1, float y1, float x2, float y2, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+	void AddOutlinedRect(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+	void AddLine(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+
+	void Flush();
+
+	bool IsEmpty() const;
+	int GetLastFlushDrawCalls() const;
+
+protected:
+	void AddQuad(const float cornersX[4], const float cornersY[4], unsigned char r, unsigned char g, unsigned char b, unsigned char a);
+
+private:
+	ShapeBatch(const ShapeBatch& shapeBatch);
+	ShapeBatch& operator=(const ShapeBatch& shapeBatch);
+
+	// Member data:
+public:
+
+protected:
+	std::vector<ShapeVertex> m_vertices;
+
+	unsigned int m_verticesPerUpload;
+
+	StreamingBuffer* m_pVertexStream;
+	unsigned int m_glVertexArray;
+
+	int m_iLastFlushDrawCalls;
+
+private:
+
+};
+
+#endif // __SHAPEBATCH_H_
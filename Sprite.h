@@ -6,6 +6,16 @@
 class Renderer;
 class Texture;
 
+// The trig for a sprite's angle, worked out once when the angle changes rather than every draw.
+// Flip, size and position are applied with it where the sprite is drawn.
+struct SpriteRotation
+{
+	float radians;
+	float cosine;
+	float sine;
+	bool bRotated; // False when the quad stays axis aligned, so bounds need no trig either
+};
+
 class Sprite
 {
 	// Member methods:
@@ -24,6 +34,8 @@ public:
 	int GetOriginalWidth() const { return m_width; }
 	int GetOriginalHeight() const { return m_height; }
 
+	Texture* GetTexture() const { return m_pTexture; }
+
 	void SetX(int x);
 	int GetX() const;
 	void SetY(int y);
@@ -31,6 +43,7 @@ public:
 
 	void SetAngle(float angle);
 	float GetAngle() const;
+	const SpriteRotation& GetRotation() const;
 
 	// scaling methods
 	void SetScale(float scaleX, float scaleY);
@@ -52,8 +65,13 @@ public:
 	void SetFlipHorizontal(bool flip);
 	bool IsFlippedHorizontal() const;
 
+	// Indexed textures only: draw with another palette row, e.g. one from TextureManager::AddPalette
+	void SetPaletteRow(unsigned int paletteRow);
+	unsigned int GetPaletteRow() const;
+
 protected:
 	float Clamp(float minimum, float value, float maximum);
+	void UpdateRotation() const;
 
 private:
 	Sprite(const Sprite& sprite);
@@ -68,6 +86,8 @@ protected:
 	int m_y;
 
 	float m_angle;
+	mutable SpriteRotation m_rotation;
+	mutable bool m_bRotationDirty;
 	int m_centerX;
 	int m_centerY;
 
@@ -84,6 +104,8 @@ protected:
 
 	bool m_bFlipHorizontal;
 
+	unsigned int m_uiPaletteRow;
+
 private:
 };
 
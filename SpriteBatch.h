@@ -0,0 +1,120 @@
+// COMP710 GP Framework 2025
+#ifndef __SPRITEBATCH_H_
+#define __SPRITEBATCH_H_
+
+// Library includes:
+#include <vector>
+
+// Forward Declarations:
+class StreamingBuffer;
+struct VertexFormat;
+
+// UV rectangle of a quad. (u0, v0) maps to the local top left corner and (u1, v1) to the bottom right.
+struct SpriteUVRect
+{
+	float u0;
+	float v0;
+	float u1;
+	float v1;
+};
+
+// Per-instance attributes, expanded onto the shared unit quad by sprite.vert.
+struct SpriteInstance
+{
+	float x;
+	float y;
+	float sizeX;
+	float sizeY;
+	float angle; // Radians
+	float flip; // -1.0f when flipped horizontally, 1.0f otherwise
+	SpriteUVRect uvs;
+	float r;
+	float g;
+	float b;
+	float a;
+	unsigned int layer; // Texture array layer, 0 for 2D textures
+	unsigned int palette; // Palette atlas row for indexed textures, PaletteAtlas::NO_PALETTE otherwise
+};
+
+// What a SpriteInstance becomes on the GPU, 32 bytes instead of 64. Position stays 32-bit so
+// world coordinates keep sub-pixel precision, size and rotation are half floats, the UV rect is
+// unorm16 and the tint RGBA8.
+struct PackedSpriteInstance
+{
+	float x;
+	float y;
+	unsigned short sizeX;
+	unsigned short sizeY;
+	unsigned short angle;
+	unsigned short flip;
+	unsigned short uvs[4];
+	unsigned char r;
+	unsigned char g;
+	unsigned char b;
+	unsigned char a;
+	unsigned short layer;
+	unsigned short palette;
+};
+
+// The instance VertexFormat's offsets and stride assume this layout
+static_assert(sizeof(PackedSpriteInstance) == 32, "PackedSpriteInstance must stay 32 bytes, with no padding");
+
+class SpriteBatch
+{
+	// Member methods:
+public:
+	SpriteBatch();
+	~SpriteBatch();
+
+	// bTextureArrays: the textures added are GL_TEXTURE_2D_ARRAY, drawn with a sampler2DArray program
+	bool Initialise(unsigned int maxInstances, bool bTextureArrays = false);
+
+	void AddSprite(unsigned int textureId, const SpriteInstance& instance);
+	void Flush();
+
+	bool IsEmpty() const;
+	bool IsFull() const;
+	int GetLastFlushDrawCalls() const;
+
+	static void PackInstance(PackedSpriteInstance& packed, const SpriteInstance& instance);
+
+protected:
+	void SetInstanceAttributes(unsigned int byteOffset);
+	static const VertexFormat& GetInstanceFormat();
+
+	static unsigned short PackUnorm16(float value);
+	static unsigned char PackUnorm8(float value);
+
+private:
+	SpriteBatch(const SpriteBatch& spriteBatch);
+	SpriteBatch& operator=(const SpriteBatch& spriteBatch);
+
+	// Member data:
+public:
+
+protected:
+	// Consecutive instances sharing a texture, drawn with a single glDrawElementsInstanced.
+	struct TextureRun
+	{
+		unsigned int textureId;
+		unsigned int firstInstance;
+		unsigned int numInstances;
+	};
+
+	std::vector<PackedSpriteInstance> m_instances;
+	std::vector<TextureRun> m_runs;
+
+	unsigned int m_maxInstances;
+	bool m_bTextureArrays;
+	int m_iLastFlushDrawCalls;
+
+	unsigned int m_glQuadBuffer;
+	unsigned int m_glIndexBuffer;
+	StreamingBuffer* m_pInstanceStream;
+	unsigned int m_glVertexArray;
+
+private:
+
+};
+
+#endif // __SPRITEBATCH_H_
@@ -3,6 +3,8 @@
 #define __TEXTURE_H_
 
 #include <SDL_image.h>
+#include <string>
+#include <vector>
 
 class Texture
 {
@@ -11,17 +13,47 @@ public:
 	Texture();
 	~Texture();
 
-	bool Initialise(const char* pcFilename);
+	// bAllowIndexed: sheets of 256 colours or fewer upload as an R8 index texture plus a palette
+	bool Initialise(const char* pcFilename, bool bAllowIndexed = false);
+
+	// A sub-rectangle of an atlas page, drawn with the page's GL texture. The page must outlive it.
+	bool InitialiseRegion(const Texture& page, int x, int y, int width, int height);
 
 	void SetActive();
 
 	int GetWidth() const;
 	int GetHeight() const;
+	unsigned int GetTextureId() const;
+
+	// Maps a 0..1 coordinate across this texture to one on the GL texture it is drawn from
+	bool IsRegion() const;
+	float MapU(float u) const;
+	float MapV(float v) const;
+	void GetRegion(int& x, int& y, int& pageWidth, int& pageHeight) const;
+
+	bool IsIndexed() const;
+	const std::vector<unsigned int>& GetPalette() const;
+	void SetPaletteRow(unsigned int paletteRow);
+	unsigned int GetPaletteRow() const;
+
+	// Drops the GL texture but keeps the size and palette, for sheets a TextureArray draws instead.
+	// RestoreStorage loads the file again should the sheet be drawn as a 2D texture after all.
+	void ReleaseStorage();
+	bool RestoreStorage();
+	bool IsStorageReleased() const;
 
 	void LoadTextTexture(const char* text, const char* fontname, int pointsize);
 	void LoadSurfaceIntoTexture(SDL_Surface* pSurface);
 
+	// Headless (NullRenderer): textures only take their size, from the image header, and never touch GL
+	static void SetHeadless(bool headless);
+	static bool IsHeadless();
+
 protected:
+	static bool ReadImageSize(const char* pcFilename, int& width, int& height);
+
+	bool InitialiseIndexed(SDL_Surface* pSurface);
+	static void RestoreDefaultUnpackState();
 
 private:
 	Texture(const Texture& texture);
@@ -35,6 +67,23 @@ protected:
 	int m_iWidth;
 	int m_iHeight;
 
+	// Atlas regions only: where this texture sits on its page. A region doesn't own the GL texture.
+	bool m_bOwnsTexture;
+
+	// Files only: what RestoreStorage loads again
+	std::string m_filename;
+	bool m_bStorageReleased;
+	int m_iRegionX;
+	int m_iRegionY;
+	int m_iPageWidth;
+	int m_iPageHeight;
+
+	// Indexed textures only: RGBA8 colours in index order, and where the TextureManager put them
+	std::vector<unsigned int> m_palette;
+	unsigned int m_uiPaletteRow;
+
+	static bool sm_bHeadless;
+
 private:
 
 };
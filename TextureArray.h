@@ -0,0 +1,53 @@
+// COMP710 GP Framework 2025
+#ifndef __TEXTUREARRAY_H_
+#define __TEXTUREARRAY_H_
+
+// Library includes:
+#include <vector>
+
+// Every frame of a family of same sized sprite sheets (e.g. all of an enemy's states) as the
+// layers of one GL_TEXTURE_2D_ARRAY, so any mix of those states draws without a texture rebind.
+// Each sheet's frames are consecutive layers, in the same order as its FrameTable.
+class TextureArray
+{
+	// Member methods:
+public:
+	TextureArray();
+	~TextureArray();
+
+	// bIndexed: upload palette indices instead of RGBA8. Each sheet keeps the palette its own
+	// indexed Texture has, so all of them must index, or the array falls back to RGBA8.
+	bool Initialise(const char* const* pcFilenames, int numFiles, int frameWidth, int frameHeight, bool bIndexed = false);
+
+	unsigned int GetTextureId() const;
+	int GetFrameWidth() const;
+	int GetFrameHeight() const;
+	int GetLayerCount() const;
+	bool IsIndexed() const;
+
+	// Layer holding frame 0 of the given sheet, in the order the files were passed to Initialise
+	int GetFirstLayer(int fileIndex) const;
+
+protected:
+	static void RestoreDefaultUnpackState();
+
+private:
+	TextureArray(const TextureArray& textureArray);
+	TextureArray& operator=(const TextureArray& textureArray);
+
+	// Member data:
+public:
+
+protected:
+	unsigned int m_uiTextureId;
+	int m_iFrameWidth;
+	int m_iFrameHeight;
+	int m_iLayerCount;
+	bool m_bIndexed;
+	std::vector<int> m_firstLayers;
+
+private:
+
+};
+
+#endif // __TEXTUREARRAY_H_
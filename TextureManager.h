@@ -2,12 +2,36 @@
 #ifndef __TEXTUREMANAGER_H_
 #define __TEXTUREMANAGER_H_
 
+// Local includes:
+#include "spritebatch.h"
+#include "atlasmanifest.h"
+
 // Library includes:
 #include <string>
 #include <map>
+#include <vector>
 
 // Forward Declarations:
 class Texture;
+class TextureArray;
+class PaletteAtlas;
+
+// UV rects of every fixed size frame in a sprite sheet, shared by all AnimatedSprites using that sheet.
+// Each rect covers only the frame's opaque bounds, so quads are drawn no bigger than the visible pixels.
+// When the sheet is part of a texture array, frame N is also layer firstLayer + N of that array.
+struct FrameTable
+{
+	Texture* pTexture; // Not const, a table read at a size its texture array wasn't cut at restores the 2D sheet
+	int frameWidth;
+	int frameHeight;
+	int refCount;
+	std::vector<SpriteUVRect> frames;
+	std::vector<FrameTrim> trims;
+
+	unsigned int arrayTextureId; // 0 when the sheet is only a 2D texture
+	int firstLayer;
+	bool bArrayIndexed;
+};
 
 class TextureManager
 {
@@ -19,8 +43,38 @@ public:
 	bool Initialize();
 	void AddTexture(const char* key, Texture* pTexture);
 
+	// Images packed by the atlas build step come back as regions of an atlas page, under their original path
 	Texture* GetTexture(const char* pcFilename);
+
+	// Ref-counted, every Acquire must be matched by a Release
+	const FrameTable* AcquireFrameTable(Texture& texture, int frameWidth, int frameHeight);
+	void ReleaseFrameTable(const FrameTable* pFrameTable);
+
+	// Packs the frames of same sized sheets (one entity's states) into one texture array, built once
+	// per family name. Sprites on those sheets with that frame size then draw from the array.
+	const TextureArray* CreateTextureArray(const char* pcFamily, const char* const* pcFilenames, int numFiles, int frameWidth, int frameHeight);
+
+	// Indexed textures share one palette atlas. A recoloured variant is a copy of a texture's
+	// GetPalette() with some colours changed, added here and set on the sprites that use it.
+	unsigned int AddPalette(const std::vector<unsigned int>& colours);
+	unsigned int GetPaletteTextureId() const;
+
+	// Each frame's opaque bounds, from alpha values pixelBytes apart in rows pitch bytes apart.
+	// The atlas build step trims with it offline, sheets it didn't trim are read back from GL.
+	static void TrimFrames(const unsigned char* pAlpha, int pixelBytes, int pitch, int sheetWidth, int sheetHeight
+		, int frameWidth, int frameHeight, std::vector<FrameTrim>& trims);
+
 protected:
+	Texture* LoadTexture(const char* pcFilename);
+	Texture* LoadAtlasRegion(const char* pcFilename);
+
+	void LoadManifestTrims(const char* pcFilename, const Texture& texture);
+	const std::vector<FrameTrim>& GetFrameTrims(const Texture& texture, int frameWidth, int frameHeight);
+	void BuildFrameTable(FrameTable& frameTable);
+	static void ReadBackFrameTrims(const Texture& texture, int frameWidth, int frameHeight, std::vector<FrameTrim>& trims);
+	void LinkTextureArray(FrameTable& frameTable) const;
+	void RestoreUnlinkedSheet(const FrameTable& frameTable);
+
 
 private:
 	TextureManager(const TextureManager& textureManager);
@@ -32,6 +86,43 @@ public:
 protected:
 	std::map<std::string, Texture*> m_pLoadedTextures;
 
+	PaletteAtlas* m_pPaletteAtlas;
+
+	// Optional, without assets/atlas/atlas.bin every image loads as its own texture.
+	// Pages load the first time a region on them is asked for.
+	AtlasManifest* m_pAtlasManifest;
+	std::vector<Texture*> m_atlasPages;
+
+	struct FrameTableKey
+	{
+		const Texture* pTexture;
+		int frameWidth;
+		int frameHeight;
+
+		bool operator<(const FrameTableKey& other) const
+		{
+			if (pTexture != other.pTexture) return pTexture < other.pTexture;
+			if (frameWidth != other.frameWidth) return frameWidth < other.frameWidth;
+			return frameHeight < other.frameHeight;
+		}
+	};
+
+	std::map<FrameTableKey, FrameTable*> m_frameTables;
+
+	// Filled from the atlas manifest as sheets load, otherwise read back from GL the first time a
+	// sheet is cut at a size. Either way it outlives the frame tables built from it.
+	std::map<FrameTableKey, std::vector<FrameTrim> > m_frameTrims;
+
+	// Where each sheet that belongs to a texture array starts in it
+	struct TextureArrayLayers
+	{
+		const TextureArray* pTextureArray;
+		int firstLayer;
+	};
+
+	std::map<std::string, TextureArray*> m_textureArrays;
+	std::map<const Texture*, TextureArrayLayers> m_textureArrayLayers;
+
 private:
 
 };
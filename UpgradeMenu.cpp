@@ -346,7 +346,7 @@ void UpgradeMenu::Draw(Renderer& renderer)
     if (!m_bIsActive || !m_pRenderer) return;
 
     // Draw panel background
-    renderer.DrawDebugRect(m_panelX, m_panelY, m_panelX + m_panelWidth, m_panelY + m_panelHeight, 10, 10, 10, 230);
+    renderer.DrawFilledRect(m_panelX, m_panelY, m_panelX + m_panelWidth, m_panelY + m_panelHeight, 10, 10, 10, 230);
 
     if (m_pUpgradeMenuTitleSprite) m_pUpgradeMenuTitleSprite->Draw(renderer);
     if (m_pEssenceTextSprite) m_pEssenceTextSprite->Draw(renderer);
@@ -358,7 +358,7 @@ void UpgradeMenu::Draw(Renderer& renderer)
         bool isActiveButton = btn.isHovered || (&btn == &m_upgradeButtons[m_selectedUpgradeButtonIndex] && m_selectedUpgradeButtonIndex != -1);
         if (isActiveButton) { r = 70; g = 70; b = 75; }
 
-        renderer.DrawDebugRect(btn.rect.x, btn.rect.y,
+        renderer.DrawFilledRect(btn.rect.x, btn.rect.y,
             btn.rect.x + btn.rect.width, btn.rect.y + btn.rect.height,
             r, g, b, a);
         if (btn.textSprite) 
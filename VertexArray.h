@@ -2,37 +2,81 @@
 #ifndef __VERTEXTARRAY_H_
 #define __VERTEXTARRAY_H_
 
-class VertexArray
+// Library includes:
+#include <glew.h>
+#include <cstddef>
+
+// One attribute of a vertex format, as handed to glVertexAttribPointer.
+struct VertexAttribute
+{
+	GLuint location;
+	GLint components;
+	GLenum type; // GL_FLOAT, GL_HALF_FLOAT, GL_SHORT, GL_UNSIGNED_SHORT, GL_UNSIGNED_BYTE...
+	GLboolean normalized;
+	unsigned int offset;
+};
+
+// Describes how an interleaved buffer feeds a shader, so layouts are data rather than code.
+struct VertexFormat
+{
+	const VertexAttribute* pAttributes;
+	unsigned int numAttributes;
+	unsigned int stride;
+	GLuint divisor; // 0 per vertex, 1 per instance
+};
+
+// Once per vertex array: enables the attributes and sets their divisor
+void EnableVertexFormat(const VertexFormat& format);
+
+// Points the attributes at the buffer bound to GL_ARRAY_BUFFER, starting baseOffset bytes in
+void PointVertexFormat(const VertexFormat& format, size_t baseOffset);
+
+// IEEE half precision, for GL_HALF_FLOAT attributes
+unsigned short FloatToHalf(float value);
+
+// Ring buffer for vertex data rewritten every frame, split into partitions the GPU and CPU take
+// turns on. Where ARB_buffer_storage exists the whole ring is mapped once, persistently and
+// coherently, so an upload is a memcpy and a fence per partition guards reuse. Otherwise
+// the buffer is orphaned each time the ring wraps and written through unsynchronized maps.
+class StreamingBuffer
 {
 	// Member methods:
 public:
-	VertexArray(const float* pVertices, unsigned int numVertices, const unsigned int* pIndices, unsigned int numIndicies);
-	~VertexArray();
+	StreamingBuffer();
+	~StreamingBuffer();
+
+	bool Initialise(unsigned int partitionSize);
 
-	void SetActive();
+	// Copies the data into the ring and leaves the buffer bound to GL_ARRAY_BUFFER. Returns the
+	// byte offset of the copy, a multiple of alignment (e.g. the vertex stride) from the buffer start.
+	unsigned int Upload(const void* pData, unsigned int size, unsigned int alignment);
 
-	unsigned int GetNumVertices() const;
-	unsigned int GetNumIndices() const;
+	unsigned int GetBuffer() const;
+	unsigned int GetPartitionSize() const;
+	bool IsPersistent() const;
 
 protected:
+	void NextPartition();
 
 private:
-	VertexArray(const VertexArray& vertexArray);
-	VertexArray& operator=(const VertexArray& vertexArray);
+	StreamingBuffer(const StreamingBuffer& streamingBuffer);
+	StreamingBuffer& operator=(const StreamingBuffer& streamingBuffer);
 
 	// Member data:
 public:
+	static const unsigned int NUM_PARTITIONS = 3;
 
 protected:
-	unsigned int m_numVertices;
-	unsigned int m_numIndices;
+	unsigned int m_glBuffer;
+	unsigned int m_partitionSize;
+	unsigned int m_partition;
+	unsigned int m_offset; // Bytes used in the current partition
 
-	unsigned int m_glVertexBuffer;
-	unsigned int m_glIndexBuffer;
-	unsigned int m_glVertexArray;
+	unsigned char* m_pMapped;
+	GLsync m_fences[NUM_PARTITIONS];
 
 private:
 
 };
 
-#endif // __VERTEXTARRAY_H_
\ No newline at end of file
+#endif // __VERTEXTARRAY_H_
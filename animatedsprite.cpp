@@ -3,8 +3,8 @@
 
 // Local include
 #include "renderer.h"
-#include "vertexarray.h"
 #include "texture.h"
+#include "texturemanager.h"
 #include "imgui/imgui.h"
 
 // Lib includes
@@ -12,7 +12,8 @@
 #include <cmath>
 
 AnimatedSprite::AnimatedSprite()
-	: m_pVertexData(0)
+	: m_pTextureManager(0)
+	, m_pFrameTable(0)
 	, m_iFrameWidth(0)
 	, m_iFrameHeight(0)
 	, m_iCurrentFrame(0)
@@ -30,8 +31,11 @@ AnimatedSprite::AnimatedSprite()
 
 AnimatedSprite::~AnimatedSprite()
 {
-	delete m_pVertexData;
-	m_pVertexData = 0;
+	if (m_pTextureManager)
+	{
+		m_pTextureManager->ReleaseFrameTable(m_pFrameTable);
+	}
+	m_pFrameTable = 0;
 }
 
 bool
@@ -58,78 +62,26 @@ AnimatedSprite::IsAnimating() const
 	return m_bAnimating;
 }
 
+void
+AnimatedSprite::SetTextureManager(TextureManager* pTextureManager)
+{
+	m_pTextureManager = pTextureManager;
+}
+
 void
 AnimatedSprite::SetupFrames(int fixedFrameWidth, int fixedFrameHeight)
 {
+	assert(m_pTextureManager);
+
 	m_iFrameWidth = fixedFrameWidth;
 	m_iFrameHeight = fixedFrameHeight;
 
-	const int textureWidth = m_pTexture->GetWidth();
-	const int textureHeight = m_pTexture->GetHeight();
-	const int totalFramesWide = textureWidth / fixedFrameWidth;
-	const int totalFramesHigh = textureHeight / fixedFrameHeight;
-
-	const int stride = 5;
-	const float uFrameWidth = 1.0f / totalFramesWide;
-	const float vFrameHeight = 1.0f / totalFramesHigh;
-	m_iTotalFrames = totalFramesWide * totalFramesHigh;
-
-	const int vertsPerSprite = 4;
-	const int numVertices = vertsPerSprite * (m_iTotalFrames);
-
-	float* vertices = new float[numVertices * stride];
+	// Frame tables are shared per sheet and frame size, so re-setting up frames never allocates per sprite
+	const FrameTable* pPrevious = m_pFrameTable;
+	m_pFrameTable = m_pTextureManager->AcquireFrameTable(*m_pTexture, fixedFrameWidth, fixedFrameHeight);
+	m_pTextureManager->ReleaseFrameTable(pPrevious);
 
-	for (int h = 0; h < totalFramesHigh; ++h)
-	{
-		for (int w = 0; w < totalFramesWide; ++w)
-		{
-			float uOffset = (w * uFrameWidth);
-			float vOffset = (h * vFrameHeight);
-
-			float quad[] =
-			{
-				-0.5f, 0.5f, 0.0f,		   0.0f + uOffset, vOffset + vFrameHeight,
-				 0.5f, 0.5f, 0.0f,	uFrameWidth + uOffset, vOffset + vFrameHeight,
-				 0.5f, -0.5f, 0.0f, uFrameWidth + uOffset, vOffset,
-				-0.5f, -0.5f, 0.0f,		   0.0f + uOffset, vOffset
-			};
-
-			const int floatPerSprite = stride * vertsPerSprite;
-
-			for (int j = 0; j < floatPerSprite; ++j)
-			{
-				int index = ((w * floatPerSprite) + j) + (h * (floatPerSprite * totalFramesWide));
-
-				vertices[index] = quad[j];
-			}
-		}
-	}
-
-	const int totalIndices = 6 * m_iTotalFrames;
-	unsigned int* allIndices = new unsigned int[totalIndices];
-
-	unsigned int i = 0;
-	for (int k = 0; k < m_iTotalFrames; ++k)
-	{
-		unsigned int indices[] = { 0 + i, 1 + i, 2 + i, 2 + i, 3 + i, 0 + i };
-
-		for (int j = 0; j < 6; ++j)
-		{
-			int index = (k * 6) + j;
-
-			allIndices[index] = indices[j];
-		}
-
-		i += 4;
-	}
-
-	m_pVertexData = new VertexArray(vertices, numVertices, allIndices, totalIndices);
-
-	delete vertices;
-	vertices = 0;
-
-	delete allIndices;
-	allIndices = 0;
+	m_iTotalFrames = static_cast<int>(m_pFrameTable->frames.size());
 }
 
 void
@@ -183,10 +135,8 @@ AnimatedSprite::IsFlippedHorizontal() const
 void
 AnimatedSprite::Draw(Renderer& renderer)
 {
-	assert(m_pVertexData);
-	m_pTexture->SetActive();
-	m_pVertexData->SetActive(); // Set the vertex data required for this animated sprite before drawing it
-	renderer.DrawAnimatedSprite(*this, m_iCurrentFrame, m_bFlipHorizontal); // Draw the current frame
+	assert(m_pFrameTable);
+	renderer.DrawAnimatedSprite(*this, m_iCurrentFrame, m_bFlipHorizontal); // Queue the current frame
 }
 
 void
@@ -285,6 +235,21 @@ AnimatedSprite::GetTotalFrames() const
 	return m_iTotalFrames;
 }
 
+const SpriteUVRect&
+AnimatedSprite::GetFrameUVs(int frameIndex) const
+{
+	assert(m_pFrameTable);
+	assert(frameIndex >= 0 && frameIndex < static_cast<int>(m_pFrameTable->frames.size()));
+	return m_pFrameTable->frames[frameIndex];
+}
+
+const FrameTable&
+AnimatedSprite::GetFrameTable() const
+{
+	assert(m_pFrameTable);
+	return *m_pFrameTable;
+}
+
 void
 AnimatedSprite::DebugDraw()
 {
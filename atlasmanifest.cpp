@@ -0,0 +1,315 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "atlasmanifest.h"
+
+// Local includes:
+#include "logmanager.h"
+
+// Library includes:
+#include <cassert>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+const char AtlasManifest::MANIFEST_MAGIC[4] = { 'A', 'T', 'L', '2' };
+
+AtlasManifest::AtlasManifest()
+{
+
+}
+
+AtlasManifest::~AtlasManifest()
+{
+
+}
+
+bool AtlasManifest::Load(const char* pcFilename)
+{
+	m_pages.clear();
+	m_regions.clear();
+	m_frameTrims.clear();
+
+	std::ifstream file(pcFilename, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	char magic[4];
+	file.read(magic, 4);
+	bool valid = file.good() && (memcmp(magic, MANIFEST_MAGIC, 4) == 0);
+
+	unsigned int pageCount = 0;
+	valid = valid && ReadU32(file, pageCount);
+
+	for (unsigned int k = 0; k < pageCount && valid; ++k)
+	{
+		std::string pagePath;
+		valid = ReadString(file, pagePath);
+		m_pages.push_back(pagePath);
+	}
+
+	unsigned int regionCount = 0;
+	valid = valid && ReadU32(file, regionCount);
+
+	for (unsigned int k = 0; k < regionCount && valid; ++k)
+	{
+		std::string sourcePath;
+		AtlasRegion region;
+
+		valid = ReadString(file, sourcePath)
+			&& ReadU16(file, region.page)
+			&& ReadU16(file, region.x)
+			&& ReadU16(file, region.y)
+			&& ReadU16(file, region.width)
+			&& ReadU16(file, region.height)
+			&& region.page < m_pages.size();
+
+		if (valid)
+		{
+			m_regions[sourcePath] = region;
+		}
+	}
+
+	unsigned int sheetCount = 0;
+	valid = valid && ReadU32(file, sheetCount);
+
+	for (unsigned int k = 0; k < sheetCount && valid; ++k)
+	{
+		std::string sourcePath;
+		unsigned short frameWidth = 0;
+		unsigned short frameHeight = 0;
+		unsigned int frameCount = 0;
+
+		valid = ReadString(file, sourcePath)
+			&& ReadU16(file, frameWidth)
+			&& ReadU16(file, frameHeight)
+			&& ReadU32(file, frameCount);
+
+		AtlasFrameTrims frameTrims;
+		frameTrims.frameWidth = frameWidth;
+		frameTrims.frameHeight = frameHeight;
+
+		for (unsigned int f = 0; f < frameCount && valid; ++f)
+		{
+			unsigned short x = 0;
+			unsigned short y = 0;
+			unsigned short width = 0;
+			unsigned short height = 0;
+
+			valid = ReadU16(file, x) && ReadU16(file, y) && ReadU16(file, width) && ReadU16(file, height);
+
+			FrameTrim trim = { x, y, width, height };
+			frameTrims.trims.push_back(trim);
+		}
+
+		if (valid)
+		{
+			m_frameTrims[sourcePath] = frameTrims;
+		}
+	}
+
+	if (!valid)
+	{
+		LogManager::GetInstance().Log("Atlas manifest is corrupt or from an older build, ignoring it. Run -buildatlas again.");
+		m_pages.clear();
+		m_regions.clear();
+		m_frameTrims.clear();
+	}
+
+	return valid;
+}
+
+bool AtlasManifest::Save(const char* pcFilename) const
+{
+	std::ofstream file(pcFilename, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file.write(MANIFEST_MAGIC, 4);
+
+	WriteU32(file, static_cast<unsigned int>(m_pages.size()));
+
+	for (size_t k = 0; k < m_pages.size(); ++k)
+	{
+		WriteString(file, m_pages[k]);
+	}
+
+	WriteU32(file, static_cast<unsigned int>(m_regions.size()));
+
+	std::map<std::string, AtlasRegion>::const_iterator iter = m_regions.begin();
+
+	while (iter != m_regions.end())
+	{
+		const AtlasRegion& region = iter->second;
+
+		WriteString(file, iter->first);
+		WriteU16(file, region.page);
+		WriteU16(file, region.x);
+		WriteU16(file, region.y);
+		WriteU16(file, region.width);
+		WriteU16(file, region.height);
+
+		++iter;
+	}
+
+	WriteU32(file, static_cast<unsigned int>(m_frameTrims.size()));
+
+	std::map<std::string, AtlasFrameTrims>::const_iterator trimIter = m_frameTrims.begin();
+
+	while (trimIter != m_frameTrims.end())
+	{
+		const AtlasFrameTrims& frameTrims = trimIter->second;
+
+		WriteString(file, trimIter->first);
+		WriteU16(file, static_cast<unsigned short>(frameTrims.frameWidth));
+		WriteU16(file, static_cast<unsigned short>(frameTrims.frameHeight));
+		WriteU32(file, static_cast<unsigned int>(frameTrims.trims.size()));
+
+		for (size_t f = 0; f < frameTrims.trims.size(); ++f)
+		{
+			const FrameTrim& trim = frameTrims.trims[f];
+
+			WriteU16(file, static_cast<unsigned short>(trim.x));
+			WriteU16(file, static_cast<unsigned short>(trim.y));
+			WriteU16(file, static_cast<unsigned short>(trim.width));
+			WriteU16(file, static_cast<unsigned short>(trim.height));
+		}
+
+		++trimIter;
+	}
+
+	return file.good();
+}
+
+void AtlasManifest::AddPage(const std::string& pagePath)
+{
+	m_pages.push_back(pagePath);
+}
+
+void AtlasManifest::AddRegion(const char* pcSourcePath, const AtlasRegion& region)
+{
+	assert(region.page < m_pages.size());
+	m_regions[NormalisePath(pcSourcePath)] = region;
+}
+
+void AtlasManifest::AddFrameTrims(const char* pcSourcePath, const AtlasFrameTrims& frameTrims)
+{
+	assert(frameTrims.frameWidth > 0 && frameTrims.frameWidth <= 0xFFFF);
+	assert(frameTrims.frameHeight > 0 && frameTrims.frameHeight <= 0xFFFF);
+	m_frameTrims[NormalisePath(pcSourcePath)] = frameTrims;
+}
+
+unsigned int AtlasManifest::GetPageCount() const
+{
+	return static_cast<unsigned int>(m_pages.size());
+}
+
+const std::string& AtlasManifest::GetPagePath(unsigned int page) const
+{
+	assert(page < m_pages.size());
+	return m_pages[page];
+}
+
+const AtlasRegion* AtlasManifest::FindRegion(const char* pcSourcePath) const
+{
+	std::map<std::string, AtlasRegion>::const_iterator iter = m_regions.find(NormalisePath(pcSourcePath));
+
+	if (iter == m_regions.end())
+	{
+		return 0;
+	}
+
+	return &iter->second;
+}
+
+const AtlasFrameTrims* AtlasManifest::FindFrameTrims(const char* pcSourcePath) const
+{
+	std::map<std::string, AtlasFrameTrims>::const_iterator iter = m_frameTrims.find(NormalisePath(pcSourcePath));
+
+	if (iter == m_frameTrims.end())
+	{
+		return 0;
+	}
+
+	return &iter->second;
+}
+
+std::string AtlasManifest::NormalisePath(const char* pcPath)
+{
+	std::string path(pcPath);
+
+	for (size_t k = 0; k < path.size(); ++k)
+	{
+		path[k] = (path[k] == '\\') ? '/' : static_cast<char>(tolower(static_cast<unsigned char>(path[k])));
+	}
+
+	return path;
+}
+
+bool AtlasManifest::ReadU16(std::istream& stream, unsigned short& value)
+{
+	unsigned char bytes[2];
+	stream.read(reinterpret_cast<char*>(bytes), 2);
+
+	value = static_cast<unsigned short>(bytes[0] | (bytes[1] << 8));
+	return stream.good();
+}
+
+bool AtlasManifest::ReadU32(std::istream& stream, unsigned int& value)
+{
+	unsigned char bytes[4];
+	stream.read(reinterpret_cast<char*>(bytes), 4);
+
+	value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<unsigned int>(bytes[3]) << 24);
+	return stream.good();
+}
+
+bool AtlasManifest::ReadString(std::istream& stream, std::string& value)
+{
+	unsigned short length = 0;
+
+	if (!ReadU16(stream, length))
+	{
+		return false;
+	}
+
+	value.resize(length);
+
+	if (length > 0)
+	{
+		stream.read(&value[0], length);
+	}
+
+	return stream.good();
+}
+
+void AtlasManifest::WriteU16(std::ostream& stream, unsigned short value)
+{
+	unsigned char bytes[2] = { static_cast<unsigned char>(value & 0xFF), static_cast<unsigned char>(value >> 8) };
+	stream.write(reinterpret_cast<const char*>(bytes), 2);
+}
+
+void AtlasManifest::WriteU32(std::ostream& stream, unsigned int value)
+{
+	unsigned char bytes[4] =
+	{
+		static_cast<unsigned char>(value & 0xFF),
+		static_cast<unsigned char>((value >> 8) & 0xFF),
+		static_cast<unsigned char>((value >> 16) & 0xFF),
+		static_cast<unsigned char>(value >> 24)
+	};
+	stream.write(reinterpret_cast<const char*>(bytes), 4);
+}
+
+void AtlasManifest::WriteString(std::ostream& stream, const std::string& value)
+{
+	assert(value.size() <= 0xFFFF);
+	WriteU16(stream, static_cast<unsigned short>(value.size()));
+	stream.write(value.data(), value.size());
+}
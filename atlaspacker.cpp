@@ -0,0 +1,278 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "atlaspacker.h"
+
+// Local includes:
+#include "atlasmanifest.h"
+#include "texturemanager.h"
+#include "logmanager.h"
+
+// Library includes:
+#include <SDL.h>
+#include <SDL_image.h>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+
+// Private copy of the packer imgui already bundles, static so it can't clash with imgui's
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imgui/imstb_rectpack.h"
+
+AtlasPacker::AtlasPacker()
+{
+
+}
+
+AtlasPacker::~AtlasPacker()
+{
+	for (size_t k = 0; k < m_sources.size(); ++k)
+	{
+		SDL_FreeSurface(m_sources[k].pSurface);
+	}
+
+	m_sources.clear();
+}
+
+bool AtlasPacker::AddSourceList(const char* pcListFilename)
+{
+	std::ifstream listFile(pcListFilename);
+
+	if (!listFile.is_open())
+	{
+		LogManager::GetInstance().Log("Atlas packer: source list not found!");
+		return false;
+	}
+
+	bool added = true;
+	std::string line;
+
+	while (std::getline(listFile, line))
+	{
+		// Tolerate Windows line endings and trailing spaces
+		while (!line.empty() && (line[line.size() - 1] == '\r' || line[line.size() - 1] == ' '))
+		{
+			line.erase(line.size() - 1);
+		}
+
+		if (line.empty() || line[0] == '#')
+		{
+			continue;
+		}
+
+		std::istringstream fields(line);
+		std::string path;
+		int frameWidth = 0;
+		int frameHeight = 0;
+		fields >> path;
+
+		if (!(fields >> frameWidth >> frameHeight))
+		{
+			frameWidth = 0;
+			frameHeight = 0;
+		}
+
+		added = AddImage(path.c_str(), frameWidth, frameHeight) && added;
+	}
+
+	return added;
+}
+
+bool AtlasPacker::AddImage(const char* pcPath, int frameWidth, int frameHeight)
+{
+	SDL_Surface* pLoaded = IMG_Load(pcPath);
+
+	if (pLoaded == 0)
+	{
+		LogManager::GetInstance().Log(("Atlas packer: failed to load " + std::string(pcPath)).c_str());
+		return false;
+	}
+
+	SourceImage source;
+	source.path = pcPath;
+	source.frameWidth = frameWidth;
+	source.frameHeight = frameHeight;
+	source.pSurface = SDL_ConvertSurfaceFormat(pLoaded, SDL_PIXELFORMAT_RGBA32, 0);
+	SDL_FreeSurface(pLoaded);
+
+	if (source.pSurface == 0)
+	{
+		return false;
+	}
+
+	// Copy alpha as it is when blitting onto the page, rather than blending it
+	SDL_SetSurfaceBlendMode(source.pSurface, SDL_BLENDMODE_NONE);
+
+	m_sources.push_back(source);
+
+	return true;
+}
+
+bool AtlasPacker::Build(const char* pcOutputDirectory, int pageSize)
+{
+	assert(pageSize > 0 && pageSize <= 0xFFFF);
+
+	AtlasManifest manifest;
+
+	for (size_t k = 0; k < m_sources.size(); ++k)
+	{
+		const SourceImage& source = m_sources[k];
+
+		if (source.frameWidth <= 0 || source.frameHeight <= 0)
+		{
+			continue;
+		}
+
+		// RGBA32 is R, G, B, A in memory on every platform, so alpha is the fourth byte
+		AtlasFrameTrims frameTrims;
+		frameTrims.frameWidth = source.frameWidth;
+		frameTrims.frameHeight = source.frameHeight;
+		TextureManager::TrimFrames(static_cast<const unsigned char*>(source.pSurface->pixels) + 3, 4, source.pSurface->pitch
+			, source.pSurface->w, source.pSurface->h, source.frameWidth, source.frameHeight, frameTrims.trims);
+
+		manifest.AddFrameTrims(source.path.c_str(), frameTrims);
+	}
+
+	std::vector<int> remaining;
+	for (int k = 0; k < static_cast<int>(m_sources.size()); ++k)
+	{
+		remaining.push_back(k);
+	}
+
+	std::vector<stbrp_node> nodes(pageSize);
+	bool built = true;
+
+	while (!remaining.empty())
+	{
+		stbrp_context context;
+		stbrp_init_target(&context, pageSize, pageSize, &nodes[0], pageSize);
+
+		std::vector<stbrp_rect> rects(remaining.size());
+
+		for (size_t k = 0; k < remaining.size(); ++k)
+		{
+			const SDL_Surface* pSurface = m_sources[remaining[k]].pSurface;
+
+			rects[k].id = remaining[k];
+			rects[k].w = pSurface->w + PADDING;
+			rects[k].h = pSurface->h + PADDING;
+			rects[k].x = 0;
+			rects[k].y = 0;
+			rects[k].was_packed = 0;
+		}
+
+		stbrp_pack_rects(&context, &rects[0], static_cast<int>(rects.size()));
+
+		std::vector<int> unpacked;
+		int pageHeight = 0;
+
+		for (size_t k = 0; k < rects.size(); ++k)
+		{
+			if (rects[k].was_packed)
+			{
+				int bottom = rects[k].y + rects[k].h;
+				pageHeight = (bottom > pageHeight) ? bottom : pageHeight;
+			}
+			else
+			{
+				unpacked.push_back(rects[k].id);
+			}
+		}
+
+		if (pageHeight == 0)
+		{
+			// Nothing fits even on an empty page
+			for (size_t k = 0; k < unpacked.size(); ++k)
+			{
+				LogManager::GetInstance().Log(("Atlas packer: too big for a page, left unpacked: " + m_sources[unpacked[k]].path).c_str());
+			}
+			break;
+		}
+
+		// Only as tall as the page's content, the last page is usually far from full
+		SDL_Surface* pPage = SDL_CreateRGBSurfaceWithFormat(0, pageSize, pageHeight, 32, SDL_PIXELFORMAT_RGBA32);
+
+		if (pPage == 0)
+		{
+			built = false;
+			break;
+		}
+
+		SDL_FillRect(pPage, 0, 0);
+
+		const unsigned short pageIndex = static_cast<unsigned short>(manifest.GetPageCount());
+
+		std::ostringstream pagePath;
+		pagePath << pcOutputDirectory << "/page" << pageIndex << ".png";
+		manifest.AddPage(pagePath.str());
+
+		for (size_t k = 0; k < rects.size(); ++k)
+		{
+			if (!rects[k].was_packed)
+			{
+				continue;
+			}
+
+			SourceImage& source = m_sources[rects[k].id];
+
+			SDL_Rect destination = { rects[k].x, rects[k].y, source.pSurface->w, source.pSurface->h };
+			SDL_BlitSurface(source.pSurface, 0, pPage, &destination);
+
+			AtlasRegion region;
+			region.page = pageIndex;
+			region.x = static_cast<unsigned short>(rects[k].x);
+			region.y = static_cast<unsigned short>(rects[k].y);
+			region.width = static_cast<unsigned short>(source.pSurface->w);
+			region.height = static_cast<unsigned short>(source.pSurface->h);
+
+			manifest.AddRegion(source.path.c_str(), region);
+		}
+
+		if (IMG_SavePNG(pPage, pagePath.str().c_str()) != 0)
+		{
+			LogManager::GetInstance().Log(("Atlas packer: failed to write " + pagePath.str()).c_str());
+			built = false;
+		}
+
+		SDL_FreeSurface(pPage);
+
+		remaining.swap(unpacked);
+	}
+
+	std::string manifestPath = std::string(pcOutputDirectory) + "/atlas.bin";
+
+	if (built && !manifest.Save(manifestPath.c_str()))
+	{
+		LogManager::GetInstance().Log("Atlas packer: failed to write the manifest!");
+		built = false;
+	}
+
+	return built;
+}
+
+int AtlasPacker::RunBuildStep()
+{
+	if (SDL_Init(0) != 0 || (IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) == 0)
+	{
+		LogManager::GetInstance().Log("Atlas packer: SDL_image failed to start!");
+		return 1;
+	}
+
+	int result = 1;
+
+	{
+		AtlasPacker packer;
+
+		if (packer.AddSourceList("assets/atlas/sources.txt") && packer.Build("assets/atlas", 2048))
+		{
+			LogManager::GetInstance().Log("Atlas packer: done.");
+			result = 0;
+		}
+	}
+
+	IMG_Quit();
+	SDL_Quit();
+
+	return result;
+}
@@ -0,0 +1,91 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "camera2d.h"
+
+// Local includes:
+#include "matrix4.h"
+
+// Library includes:
+#include <cassert>
+
+Camera2D::Camera2D()
+	: m_fX(0.0f)
+	, m_fY(0.0f)
+	, m_fZoom(1.0f)
+	, m_fViewportWidth(0.0f)
+	, m_fViewportHeight(0.0f)
+{
+
+}
+
+Camera2D::~Camera2D()
+{
+
+}
+
+void Camera2D::SetViewportSize(float width, float height)
+{
+	m_fViewportWidth = width;
+	m_fViewportHeight = height;
+}
+
+void Camera2D::SetPosition(float x, float y)
+{
+	m_fX = x;
+	m_fY = y;
+}
+
+float Camera2D::GetX() const
+{
+	return m_fX;
+}
+
+float Camera2D::GetY() const
+{
+	return m_fY;
+}
+
+void Camera2D::SetZoom(float zoom)
+{
+	assert(zoom > 0.0f);
+	m_fZoom = zoom;
+}
+
+float Camera2D::GetZoom() const
+{
+	return m_fZoom;
+}
+
+void Camera2D::GetVisibleBounds(float& left, float& top, float& right, float& bottom) const
+{
+	float halfWidth = (m_fViewportWidth * 0.5f) / m_fZoom;
+	float halfHeight = (m_fViewportHeight * 0.5f) / m_fZoom;
+
+	left = m_fX - halfWidth;
+	right = m_fX + halfWidth;
+	top = m_fY - halfHeight;
+	bottom = m_fY + halfHeight;
+}
+
+void Camera2D::CreateViewProjection(Matrix4& mat) const
+{
+	float left = 0.0f;
+	float top = 0.0f;
+	float right = 0.0f;
+	float bottom = 0.0f;
+	GetVisibleBounds(left, top, right, bottom);
+
+	CreateOrthoProjection(mat, left, top, right, bottom);
+}
+
+bool Camera2D::IsVisible(float minX, float minY, float maxX, float maxY) const
+{
+	float left = 0.0f;
+	float top = 0.0f;
+	float right = 0.0f;
+	float bottom = 0.0f;
+	GetVisibleBounds(left, top, right, bottom);
+
+	return (maxX >= left && minX <= right && maxY >= top && minY <= bottom);
+}
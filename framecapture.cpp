@@ -0,0 +1,520 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "framecapture.h"
+
+// Local includes:
+#include "logmanager.h"
+
+// Library includes:
+#include <SDL_image.h>
+#include <cassert>
+#include <cstring>
+#include <sstream>
+
+FrameCapture::FrameCapture()
+	: m_pWriterThread(0)
+	, m_pMutex(0)
+	, m_pJobReady(0)
+	, m_iRequestedFramesPerSecond(0)
+	, m_bRecordingRequested(false)
+	, m_bRecordingRestarted(false)
+	, m_iQueuedVideoFrames(0)
+	, m_bQuit(false)
+	, m_uiFrame(0)
+	, m_bRecording(false)
+	, m_iDroppedFrames(0)
+	, m_iVideoWidth(0)
+	, m_iVideoHeight(0)
+	, m_iVideoFramesPerSecond(0)
+	, m_iVideoFrames(0)
+{
+	for (int k = 0; k < CAPTURE_SLOTS; ++k)
+	{
+		m_slots[k].glBuffer = 0;
+		m_slots[k].bufferSize = 0;
+		m_slots[k].fence = 0;
+		m_slots[k].width = 0;
+		m_slots[k].height = 0;
+		m_slots[k].bVideoFrame = false;
+		m_slots[k].bPending = false;
+	}
+}
+
+FrameCapture::~FrameCapture()
+{
+	assert(m_pWriterThread == 0); // Shutdown needs the GL context, it can't be done from here
+}
+
+bool FrameCapture::Initialise()
+{
+	m_pMutex = SDL_CreateMutex();
+	m_pJobReady = SDL_CreateCond();
+	m_bQuit = false;
+
+	m_pWriterThread = SDL_CreateThread(WriterThreadMain, "CaptureWriter", this);
+
+	if (m_pWriterThread == 0)
+	{
+		LogManager::GetInstance().Log("Frame capture: writer thread failed to start, capture is unavailable.");
+
+		SDL_DestroyCond(m_pJobReady);
+		SDL_DestroyMutex(m_pMutex);
+		m_pJobReady = 0;
+		m_pMutex = 0;
+		return false;
+	}
+
+	return true;
+}
+
+void FrameCapture::Shutdown()
+{
+	if (m_pWriterThread == 0)
+	{
+		return;
+	}
+
+	// Stalls once here rather than losing the last two frames of a screenshot or recording
+	ReadBackAll();
+
+	if (m_bRecording)
+	{
+		CaptureJob* pEnd = new CaptureJob();
+		pEnd->type = CaptureJobType::VIDEO_END;
+		QueueJob(pEnd);
+		m_bRecording = false;
+	}
+
+	// The writer empties its queue before it quits
+	SDL_LockMutex(m_pMutex);
+	m_bQuit = true;
+	SDL_CondSignal(m_pJobReady);
+	SDL_UnlockMutex(m_pMutex);
+
+	SDL_WaitThread(m_pWriterThread, 0);
+	m_pWriterThread = 0;
+
+	SDL_DestroyCond(m_pJobReady);
+	SDL_DestroyMutex(m_pMutex);
+	m_pJobReady = 0;
+	m_pMutex = 0;
+
+	for (int k = 0; k < CAPTURE_SLOTS; ++k)
+	{
+		glDeleteBuffers(1, &m_slots[k].glBuffer);
+		m_slots[k].glBuffer = 0;
+		m_slots[k].bufferSize = 0;
+	}
+}
+
+void FrameCapture::StartRecording(const char* pcFilename, int framesPerSecond)
+{
+	if (m_pMutex == 0)
+	{
+		return;
+	}
+
+	SDL_LockMutex(m_pMutex);
+	m_recordingRequest = pcFilename;
+	m_iRequestedFramesPerSecond = framesPerSecond;
+	m_bRecordingRestarted = m_bRecordingRequested;
+	m_bRecordingRequested = true;
+	SDL_UnlockMutex(m_pMutex);
+}
+
+void FrameCapture::StopRecording()
+{
+	if (m_pMutex == 0)
+	{
+		return;
+	}
+
+	SDL_LockMutex(m_pMutex);
+	m_bRecordingRequested = false;
+	m_bRecordingRestarted = false;
+	SDL_UnlockMutex(m_pMutex);
+}
+
+bool FrameCapture::IsRecording() const
+{
+	if (m_pMutex == 0)
+	{
+		return false;
+	}
+
+	SDL_LockMutex(m_pMutex);
+	bool recording = m_bRecordingRequested;
+	SDL_UnlockMutex(m_pMutex);
+
+	return recording;
+}
+
+void FrameCapture::CaptureFrame(GLuint framebuffer, int width, int height, const std::string& screenshotPath)
+{
+	if (m_pWriterThread == 0)
+	{
+		return;
+	}
+
+	SDL_LockMutex(m_pMutex);
+	bool recordingRequested = m_bRecordingRequested;
+	bool recordingRestarted = m_bRecordingRestarted;
+	std::string recordingPath = m_recordingRequest;
+	int framesPerSecond = m_iRequestedFramesPerSecond;
+	m_bRecordingRestarted = false;
+	SDL_UnlockMutex(m_pMutex);
+
+	if (m_bRecording && (!recordingRequested || recordingRestarted))
+	{
+		// Every frame of the old stream must reach the writer before it is closed
+		ReadBackAll();
+
+		CaptureJob* pEnd = new CaptureJob();
+		pEnd->type = CaptureJobType::VIDEO_END;
+		QueueJob(pEnd);
+		m_bRecording = false;
+	}
+
+	if (recordingRequested && !m_bRecording)
+	{
+		CaptureJob* pStart = new CaptureJob();
+		pStart->type = CaptureJobType::VIDEO_START;
+		pStart->path = recordingPath;
+		pStart->framesPerSecond = framesPerSecond;
+		QueueJob(pStart);
+		m_bRecording = true;
+		m_iDroppedFrames = 0;
+	}
+
+	// Frame N-2's copy has had two whole frames to finish, mapping it doesn't wait on the GPU
+	ReadBack(m_slots[(m_uiFrame + 1) % CAPTURE_SLOTS]);
+
+	if (!screenshotPath.empty() || m_bRecording)
+	{
+		CaptureSlot& slot = m_slots[m_uiFrame % CAPTURE_SLOTS];
+		assert(!slot.bPending);
+
+		const GLsizeiptr size = static_cast<GLsizeiptr>(width) * height * 4;
+
+		if (slot.glBuffer == 0)
+		{
+			glGenBuffers(1, &slot.glBuffer);
+		}
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.glBuffer);
+
+		if (slot.bufferSize != size)
+		{
+			glBufferData(GL_PIXEL_PACK_BUFFER, size, 0, GL_STREAM_READ);
+			slot.bufferSize = size;
+		}
+
+		// Into the buffer object, so this only queues the copy instead of waiting for it
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+		glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		slot.width = width;
+		slot.height = height;
+		slot.screenshotPath = screenshotPath;
+		slot.bVideoFrame = m_bRecording;
+		slot.bPending = true;
+	}
+
+	++m_uiFrame;
+}
+
+void FrameCapture::ReadBack(CaptureSlot& slot)
+{
+	if (!slot.bPending)
+	{
+		return;
+	}
+
+	slot.bPending = false;
+
+	// Normally signalled long ago, only a flush at shutdown or a recording change waits here
+	const GLuint64 ONE_SECOND = 1000000000;
+	GLenum result = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, ONE_SECOND);
+
+	while (result == GL_TIMEOUT_EXPIRED)
+	{
+		result = glClientWaitSync(slot.fence, 0, ONE_SECOND);
+	}
+
+	glDeleteSync(slot.fence);
+	slot.fence = 0;
+
+	CaptureJob* pFrame = 0;
+
+	if (slot.bVideoFrame)
+	{
+		SDL_LockMutex(m_pMutex);
+		bool full = (m_iQueuedVideoFrames >= MAX_QUEUED_VIDEO_FRAMES);
+		SDL_UnlockMutex(m_pMutex);
+
+		if (full)
+		{
+			++m_iDroppedFrames;
+		}
+		else
+		{
+			pFrame = new CaptureJob();
+			pFrame->type = CaptureJobType::VIDEO_FRAME;
+		}
+	}
+
+	CaptureJob* pScreenshot = 0;
+
+	if (!slot.screenshotPath.empty())
+	{
+		pScreenshot = new CaptureJob();
+		pScreenshot->type = CaptureJobType::SCREENSHOT;
+		pScreenshot->path.swap(slot.screenshotPath);
+	}
+
+	if (pFrame == 0 && pScreenshot == 0)
+	{
+		return;
+	}
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.glBuffer);
+	const void* pPixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.bufferSize, GL_MAP_READ_BIT);
+
+	CaptureJob* jobs[2] = { pFrame, pScreenshot };
+
+	for (int k = 0; k < 2; ++k)
+	{
+		if (jobs[k] == 0)
+		{
+			continue;
+		}
+
+		if (pPixels == 0)
+		{
+			LogManager::GetInstance().Log("Frame capture: failed to map a readback buffer, frame lost.");
+			delete jobs[k];
+			continue;
+		}
+
+		jobs[k]->width = slot.width;
+		jobs[k]->height = slot.height;
+		jobs[k]->framesPerSecond = 0;
+		jobs[k]->pixels.resize(static_cast<size_t>(slot.bufferSize));
+		memcpy(&jobs[k]->pixels[0], pPixels, static_cast<size_t>(slot.bufferSize));
+
+		QueueJob(jobs[k]);
+	}
+
+	if (pPixels != 0)
+	{
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void FrameCapture::ReadBackAll()
+{
+	// Oldest first, so video frames reach the writer in order
+	for (int k = 1; k <= CAPTURE_SLOTS; ++k)
+	{
+		ReadBack(m_slots[(m_uiFrame + k) % CAPTURE_SLOTS]);
+	}
+}
+
+void FrameCapture::QueueJob(CaptureJob* pJob)
+{
+	SDL_LockMutex(m_pMutex);
+
+	if (pJob->type == CaptureJobType::VIDEO_FRAME)
+	{
+		++m_iQueuedVideoFrames;
+	}
+	else if (pJob->type == CaptureJobType::VIDEO_END && m_iDroppedFrames > 0)
+	{
+		std::ostringstream message;
+		message << "Frame capture: the writer fell behind, " << m_iDroppedFrames << " recorded frames were dropped.";
+		LogManager::GetInstance().Log(message.str().c_str());
+	}
+
+	m_jobs.push_back(pJob);
+	SDL_CondSignal(m_pJobReady);
+	SDL_UnlockMutex(m_pMutex);
+}
+
+int FrameCapture::WriterThreadMain(void* pData)
+{
+	static_cast<FrameCapture*>(pData)->RunWriter();
+	return 0;
+}
+
+void FrameCapture::RunWriter()
+{
+	while (true)
+	{
+		SDL_LockMutex(m_pMutex);
+
+		while (m_jobs.empty() && !m_bQuit)
+		{
+			SDL_CondWait(m_pJobReady, m_pMutex);
+		}
+
+		if (m_jobs.empty())
+		{
+			SDL_UnlockMutex(m_pMutex);
+			break;
+		}
+
+		CaptureJob* pJob = m_jobs.front();
+		m_jobs.pop_front();
+
+		SDL_UnlockMutex(m_pMutex);
+
+		// Encoding and disk writes happen here, off the render thread
+		WriteJob(*pJob);
+
+		if (pJob->type == CaptureJobType::VIDEO_FRAME)
+		{
+			SDL_LockMutex(m_pMutex);
+			--m_iQueuedVideoFrames;
+			SDL_UnlockMutex(m_pMutex);
+		}
+
+		delete pJob;
+	}
+}
+
+void FrameCapture::WriteJob(const CaptureJob& job)
+{
+	switch (job.type)
+	{
+	case CaptureJobType::SCREENSHOT:
+		if (WritePng(job))
+		{
+			LogManager::GetInstance().Log(("Frame capture: saved " + job.path).c_str());
+		}
+		else
+		{
+			LogManager::GetInstance().Log(("Frame capture: failed to save " + job.path).c_str());
+		}
+		break;
+
+	case CaptureJobType::VIDEO_START:
+		m_videoFile.open(job.path.c_str(), std::ios::binary | std::ios::trunc);
+		m_videoPath = job.path;
+		m_iVideoFramesPerSecond = job.framesPerSecond;
+		m_iVideoWidth = 0;
+		m_iVideoHeight = 0;
+		m_iVideoFrames = 0;
+
+		if (!m_videoFile.is_open())
+		{
+			LogManager::GetInstance().Log(("Frame capture: failed to open " + job.path).c_str());
+		}
+		break;
+
+	case CaptureJobType::VIDEO_FRAME:
+		WriteY4mFrame(job);
+		break;
+
+	case CaptureJobType::VIDEO_END:
+		if (m_videoFile.is_open())
+		{
+			m_videoFile.close();
+
+			std::ostringstream message;
+			message << "Frame capture: recorded " << m_iVideoFrames << " frames to " << m_videoPath;
+			LogManager::GetInstance().Log(message.str().c_str());
+		}
+		break;
+	}
+}
+
+bool FrameCapture::WritePng(const CaptureJob& job)
+{
+	SDL_Surface* pSurface = SDL_CreateRGBSurfaceWithFormat(0, job.width, job.height, 32, SDL_PIXELFORMAT_RGBA32);
+
+	if (pSurface == 0)
+	{
+		return false;
+	}
+
+	const size_t rowBytes = static_cast<size_t>(job.width) * 4;
+
+	for (int y = 0; y < job.height; ++y)
+	{
+		// GL reads bottom up, PNG rows run top down
+		const unsigned char* pSource = &job.pixels[(job.height - 1 - y) * rowBytes];
+		unsigned char* pDestination = static_cast<unsigned char*>(pSurface->pixels) + (y * pSurface->pitch);
+
+		memcpy(pDestination, pSource, rowBytes);
+
+		// The back buffer's alpha is whatever blending left behind, the picture is opaque
+		for (int x = 0; x < job.width; ++x)
+		{
+			pDestination[x * 4 + 3] = 0xFF;
+		}
+	}
+
+	bool saved = (IMG_SavePNG(pSurface, job.path.c_str()) == 0);
+	SDL_FreeSurface(pSurface);
+
+	return saved;
+}
+
+void FrameCapture::WriteY4mFrame(const CaptureJob& job)
+{
+	if (!m_videoFile.is_open())
+	{
+		return;
+	}
+
+	if (m_iVideoFrames == 0)
+	{
+		// The stream's size is fixed by its first frame
+		m_iVideoWidth = job.width;
+		m_iVideoHeight = job.height;
+
+		m_videoFile << "YUV4MPEG2 W" << m_iVideoWidth << " H" << m_iVideoHeight
+			<< " F" << m_iVideoFramesPerSecond << ":1 Ip A1:1 C444\n";
+	}
+	else if (job.width != m_iVideoWidth || job.height != m_iVideoHeight)
+	{
+		// The canvas or window changed size mid recording, Y4M can't follow
+		return;
+	}
+
+	// Full resolution chroma keeps pixel art edges clean, and needs no averaging
+	const size_t planeSize = static_cast<size_t>(job.width) * job.height;
+	m_yuvPlanes.resize(planeSize * 3);
+
+	unsigned char* pY = &m_yuvPlanes[0];
+	unsigned char* pU = pY + planeSize;
+	unsigned char* pV = pU + planeSize;
+
+	for (int y = 0; y < job.height; ++y)
+	{
+		const unsigned char* pRow = &job.pixels[static_cast<size_t>(job.height - 1 - y) * job.width * 4];
+
+		for (int x = 0; x < job.width; ++x)
+		{
+			const int r = pRow[x * 4 + 0];
+			const int g = pRow[x * 4 + 1];
+			const int b = pRow[x * 4 + 2];
+
+			// BT.601, studio range
+			*pY++ = static_cast<unsigned char>(16 + ((66 * r + 129 * g + 25 * b + 128) >> 8));
+			*pU++ = static_cast<unsigned char>(128 + ((-38 * r - 74 * g + 112 * b + 128) >> 8));
+			*pV++ = static_cast<unsigned char>(128 + ((112 * r - 94 * g - 18 * b + 128) >> 8));
+		}
+	}
+
+	m_videoFile << "FRAME\n";
+	m_videoFile.write(reinterpret_cast<const char*>(&m_yuvPlanes[0]), m_yuvPlanes.size());
+
+	++m_iVideoFrames;
+}
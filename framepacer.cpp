@@ -0,0 +1,205 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "framepacer.h"
+
+// Library includes:
+#include <Windows.h>
+#include <cassert>
+#include <cmath>
+
+FramePacer::FramePacer()
+	: m_iFrameCap(0)
+	, m_iBackgroundFrameCap(0)
+	, m_bFocused(true)
+	, m_bInitialised(false)
+	, m_iNextFrameTime(0)
+	, m_iLastPresentTime(0)
+	, m_iHistoryNext(0)
+	, m_iHistoryCount(0)
+{
+	for (int k = 0; k < HISTORY_FRAMES; ++k)
+	{
+		m_history[k] = 0.0f;
+	}
+}
+
+FramePacer::~FramePacer()
+{
+	assert(!m_bInitialised);
+}
+
+void FramePacer::Initialise()
+{
+	// Without it Windows sleeps in 15.6 ms steps, longer than a whole frame at 60Hz
+	timeBeginPeriod(1);
+	m_bInitialised = true;
+}
+
+void FramePacer::Shutdown()
+{
+	if (!m_bInitialised)
+	{
+		return;
+	}
+
+	timeEndPeriod(1);
+	m_bInitialised = false;
+}
+
+void FramePacer::SetFrameCap(int framesPerSecond)
+{
+	m_iFrameCap = framesPerSecond;
+	m_iNextFrameTime = 0;
+}
+
+int FramePacer::GetFrameCap() const
+{
+	return m_iFrameCap;
+}
+
+void FramePacer::SetBackgroundFrameCap(int framesPerSecond)
+{
+	m_iBackgroundFrameCap = framesPerSecond;
+	m_iNextFrameTime = 0;
+}
+
+int FramePacer::GetBackgroundFrameCap() const
+{
+	return m_iBackgroundFrameCap;
+}
+
+void FramePacer::SetFocused(bool focused)
+{
+	if (focused != m_bFocused)
+	{
+		m_bFocused = focused;
+		m_iNextFrameTime = 0;
+	}
+}
+
+bool FramePacer::IsThrottled() const
+{
+	return !m_bFocused && m_iBackgroundFrameCap > 0;
+}
+
+int FramePacer::GetActiveCap() const
+{
+	if (IsThrottled())
+	{
+		return m_iBackgroundFrameCap;
+	}
+
+	return m_iFrameCap;
+}
+
+void FramePacer::EndFrame()
+{
+	Uint64 now = SDL_GetPerformanceCounter();
+	const Uint64 frequency = SDL_GetPerformanceFrequency();
+
+	if (m_iLastPresentTime != 0)
+	{
+		RecordInterval((now - m_iLastPresentTime) * 1000.0f / frequency);
+	}
+
+	m_iLastPresentTime = now;
+
+	const int cap = GetActiveCap();
+
+	if (cap <= 0)
+	{
+		m_iNextFrameTime = 0;
+		return;
+	}
+
+	const Uint64 period = frequency / cap;
+
+	if (m_iNextFrameTime == 0)
+	{
+		m_iNextFrameTime = now;
+	}
+
+	// Deadlines step by whole periods so waking a little late doesn't drift the rate. A frame that
+	// overran starts again from now rather than rushing the next ones to catch up.
+	m_iNextFrameTime += period;
+
+	if (m_iNextFrameTime <= now)
+	{
+		m_iNextFrameTime = now;
+		return;
+	}
+
+	WaitUntil(m_iNextFrameTime);
+}
+
+void FramePacer::WaitUntil(Uint64 deadline)
+{
+	const Uint64 frequency = SDL_GetPerformanceFrequency();
+	const Uint64 spinCounts = frequency * SPIN_MICROSECONDS / 1000000;
+
+	Uint64 now = SDL_GetPerformanceCounter();
+
+	while (now + spinCounts < deadline)
+	{
+		Uint32 milliseconds = static_cast<Uint32>((deadline - spinCounts - now) * 1000 / frequency);
+
+		if (milliseconds == 0)
+		{
+			break;
+		}
+
+		SDL_Delay(milliseconds);
+		now = SDL_GetPerformanceCounter();
+	}
+
+	while (now < deadline)
+	{
+		now = SDL_GetPerformanceCounter();
+	}
+}
+
+void FramePacer::RecordInterval(float milliseconds)
+{
+	m_history[m_iHistoryNext] = milliseconds;
+	m_iHistoryNext = (m_iHistoryNext + 1) % HISTORY_FRAMES;
+
+	if (m_iHistoryCount < HISTORY_FRAMES)
+	{
+		++m_iHistoryCount;
+	}
+}
+
+void FramePacer::GetTimings(float& averageMilliseconds, float& jitterMilliseconds, float& worstMilliseconds) const
+{
+	averageMilliseconds = 0.0f;
+	jitterMilliseconds = 0.0f;
+	worstMilliseconds = 0.0f;
+
+	if (m_iHistoryCount == 0)
+	{
+		return;
+	}
+
+	for (int k = 0; k < m_iHistoryCount; ++k)
+	{
+		averageMilliseconds += m_history[k];
+
+		if (m_history[k] > worstMilliseconds)
+		{
+			worstMilliseconds = m_history[k];
+		}
+	}
+
+	averageMilliseconds /= m_iHistoryCount;
+
+	float variance = 0.0f;
+
+	for (int k = 0; k < m_iHistoryCount; ++k)
+	{
+		float difference = m_history[k] - averageMilliseconds;
+		variance += difference * difference;
+	}
+
+	jitterMilliseconds = sqrtf(variance / m_iHistoryCount);
+}
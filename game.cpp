@@ -3,7 +3,8 @@
 #include "Game.h"
 
 // Local includes:
-#include "Renderer.h"
+#include "GLRenderer.h"
+#include "NullRenderer.h"
 #include "LogManager.h"
 #include "Sprite.h"
 #include "Scene.h"
@@ -11,10 +12,14 @@
 #include "XboxController.h"
 #include "fmod.hpp"
 #include "SoundSystem.h"
+#include "GpuTimer.h"
+#include "RenderStats.h"
+#include "FramePacer.h"
 
 // Lib icnludes
 #include <SDL_ttf.h>
 #include <cstdlib>
+#include <sstream>
 #include <crtdbg.h>
 
 //IMGUI INCLUDES
@@ -52,6 +57,7 @@ Game::Game()
 	: m_pRenderer(0)
 	, m_bLooping(true)
 	, m_pInputSystem(0)
+	, m_pFramePacer(0)
 	, m_bShowDebugWindow(0)
 	, m_iCurrentScene(0)
 	, m_fElaspedSeconds(0.0f)
@@ -60,6 +66,12 @@ Game::Game()
 	, m_iFrameCount(0)
 	, m_iLastTime(0)
 	, m_pCurrentScenePtr(nullptr)
+	, m_runMode(GameRunMode::PLAY)
+	, m_iFrameLimit(0)
+	, m_iFramesRun(0)
+	, m_iRunStartTime(0)
+	, m_iFrameCap(0)
+	, m_vsyncMode(VsyncMode::ON)
 {
 }
 
@@ -67,12 +79,7 @@ Game::~Game()
 {
 	m_pCurrentScenePtr = nullptr;
 
-	delete m_pRenderer;
-	delete m_pInputSystem;
-	m_pInputSystem = 0;
-	m_pRenderer = 0;
-
-	// Delete Scenes
+	// Delete Scenes before the renderer, their sprites release shared frame tables back to its TextureManager
 	for (Scene* scene : m_scenes)
 	{
 		delete scene;
@@ -86,6 +93,13 @@ Game::~Game()
 	delete m_pInputSystem;
 	m_pInputSystem = nullptr;
 
+	if (m_pFramePacer)
+	{
+		m_pFramePacer->Shutdown();
+	}
+	delete m_pFramePacer;
+	m_pFramePacer = nullptr;
+
 	// Libraries and subsystems
 	SoundSystem::DestroyInstance();
 	TTF_Quit();
@@ -100,15 +114,48 @@ void Game::Quit()
 	m_bLooping = false;
 }
 
+void Game::SetFrameLimit(int frames)
+{
+	m_iFrameLimit = frames;
+}
+
+void Game::SetFrameCap(int framesPerSecond)
+{
+	m_iFrameCap = framesPerSecond;
+}
+
+void Game::SetVsyncMode(VsyncMode mode)
+{
+	m_vsyncMode = mode;
+}
+
 // Where scenes will be added
-bool Game::Initialise()
+bool Game::Initialise(GameRunMode runMode)
 {
 	// WIndow screen
 	int bbWidth = 1280;
 	int bbHeight = 720;
 
-	m_pRenderer = new Renderer();
-	if (!m_pRenderer->Initialize(false, bbWidth, bbHeight))
+	m_runMode = runMode;
+
+	if (m_runMode == GameRunMode::NULL_RENDERER)
+	{
+		m_pRenderer = new NullRenderer();
+	}
+	else
+	{
+		GLRenderer* pGLRenderer = new GLRenderer();
+		pGLRenderer->SetHiddenWindow(m_runMode == GameRunMode::RENDER_HARNESS);
+		m_pRenderer = pGLRenderer;
+	}
+
+	// The art and UI are laid out for 1280x720, bigger displays get it scaled up by whole pixels
+	m_pRenderer->SetInternalResolution(1280, 720);
+
+	// Offscreen runs keep the window at the canvas size, so the canvas is never scaled
+	bool windowed = (m_runMode == GameRunMode::RENDER_HARNESS);
+
+	if (!m_pRenderer->Initialize(windowed, bbWidth, bbHeight))
 	{
 		LogManager::GetInstance().Log("Renderer failed to initialise!");
 		return false;
@@ -117,7 +164,19 @@ bool Game::Initialise()
 	bbWidth = m_pRenderer->GetWidth();
 	bbHeight = m_pRenderer->GetHeight();
 
+	// Uncapped, the loop runs the CPU and GPU flat out even on the splash screens
+	m_pFramePacer = new FramePacer();
+	m_pFramePacer->Initialise();
+
+	if (m_runMode == GameRunMode::PLAY)
+	{
+		m_pRenderer->SetVsyncMode(m_vsyncMode);
+		m_pFramePacer->SetFrameCap(m_iFrameCap);
+		m_pFramePacer->SetBackgroundFrameCap(BACKGROUND_FRAME_CAP);
+	}
+
 	m_iLastTime = SDL_GetPerformanceCounter();
+	m_iRunStartTime = m_iLastTime;
 
 	// CHange backgroudn color
 	m_pRenderer->SetClearColor(50, 50, 50);
@@ -143,6 +202,12 @@ bool Game::Initialise()
 		return false;
 	}
 
+	float canvasX = 0.0f;
+	float canvasY = 0.0f;
+	float canvasScale = 1.0f;
+	m_pRenderer->GetCanvasPlacement(canvasX, canvasY, canvasScale);
+	m_pInputSystem->SetMouseCanvas(canvasX, canvasY, canvasScale);
+
 	// Scene Test
 	m_scenes.clear();
 	m_scenes.push_back(new SceneSplashScreenFMOD());
@@ -150,6 +215,12 @@ bool Game::Initialise()
 	m_scenes.push_back(new SceneTitleScreen());
 	m_scenes.push_back(new SceneAbyssWalker());
 
+	// Nobody is watching the splash screens or pressing start on a build server
+	if (m_runMode != GameRunMode::PLAY)
+	{
+		return SetCurrentScene(SCENE_INDEX_ABYSSWALKER, true);
+	}
+
 	return SetCurrentScene(SCENE_INDEX_FMODSPLASH, true);
 
 	return true;
@@ -187,6 +258,11 @@ InputSystem* Game::GetInputSystem()
 	return m_pInputSystem;
 }
 
+Renderer* Game::GetRenderer()
+{
+	return m_pRenderer;
+}
+
 bool Game::DoGameLoop()
 {
 	const float stepSize = 1.0f / 60.0f;
@@ -204,6 +280,12 @@ bool Game::DoGameLoop()
 
 		m_iLastTime = current;
 
+		// Test runs go as fast as they can, so simulated time must not depend on the machine
+		if (m_runMode != GameRunMode::PLAY)
+		{
+			deltaTime = stepSize;
+		}
+
 		m_fExecutionTime += deltaTime;
 		
 		Process(deltaTime);
@@ -225,6 +307,24 @@ bool Game::DoGameLoop()
 #endif // USE_LAG
 
 		Draw(*m_pRenderer);
+
+		++m_iFramesRun;
+
+		if (m_iFrameLimit > 0 && m_iFramesRun >= m_iFrameLimit)
+		{
+			float seconds = (SDL_GetPerformanceCounter() - m_iRunStartTime) / static_cast<float>(SDL_GetPerformanceFrequency());
+
+			std::ostringstream report;
+			report << "Ran " << m_iFramesRun << " frames in " << seconds << "s, "
+				<< (m_iFramesRun / seconds) << " frames per second, "
+				<< (seconds * 1000.0f / m_iFramesRun) << "ms per frame.";
+			LogManager::GetInstance().Log(report.str().c_str());
+
+			Quit();
+		}
+
+		m_pFramePacer->SetFocused(m_pInputSystem->IsWindowFocused());
+		m_pFramePacer->EndFrame();
 	}
 
 	return m_bLooping;
@@ -357,6 +457,34 @@ Game::DebugDraw()
 			Quit();
 		}
 
+		// Written a couple of frames later, next to the executable
+		if (ImGui::Button("Screenshot"))
+		{
+			std::ostringstream filename;
+			filename << "screenshot_" << SDL_GetTicks() << ".png";
+			m_pRenderer->CaptureScreenshot(filename.str().c_str());
+		}
+
+		ImGui::SameLine();
+
+		if (m_pRenderer->IsRecording())
+		{
+			if (ImGui::Button("Stop recording"))
+			{
+				m_pRenderer->StopRecording();
+			}
+		}
+		else if (ImGui::Button("Record"))
+		{
+			std::ostringstream filename;
+			filename << "recording_" << SDL_GetTicks() << ".y4m";
+			m_pRenderer->StartRecording(filename.str().c_str());
+		}
+
+		DebugDrawGpuTime();
+		DebugDrawRenderStats();
+		DebugDrawFramePacing();
+
 		ImGui::SliderInt("Active scene", &m_iCurrentScene, 0, m_scenes.size() - 1, "%d");
 		m_scenes[m_iCurrentScene]->DebugDraw();
 
@@ -364,6 +492,112 @@ Game::DebugDraw()
 	}
 }
 
+void
+Game::DebugDrawGpuTime()
+{
+	GpuTimer* pGpuTimer = m_pRenderer->GetGpuTimer();
+
+	if (pGpuTimer == 0 || !ImGui::CollapsingHeader("GPU time"))
+	{
+		return;
+	}
+
+	// Rolling averages, a few frames old: a frame is GPU bound when the total nears the frame time
+	float milliseconds[GpuTimer::PASS_COUNT];
+	pGpuTimer->GetAverages(milliseconds);
+
+	float total = 0.0f;
+
+	for (int pass = 0; pass < GpuTimer::PASS_COUNT; ++pass)
+	{
+		ImGui::Text("%-10s %6.3f ms", GpuTimer::GetPassName(static_cast<GpuPass>(pass)), milliseconds[pass]);
+		total += milliseconds[pass];
+	}
+
+	ImGui::Separator();
+	ImGui::Text("%-10s %6.3f ms (%d fps)", "Total", total, m_iFPS);
+}
+
+void
+Game::DebugDrawRenderStats()
+{
+	if (!ImGui::CollapsingHeader("Renderer stats"))
+	{
+		return;
+	}
+
+	RenderStats stats;
+	m_pRenderer->GetFrameStats(stats);
+
+	ImGui::Text("Draw calls       %d", stats.drawCalls);
+	ImGui::Text("Triangles        %d", stats.triangles);
+	ImGui::Text("Program switches %d", stats.programSwitches);
+	ImGui::Text("Texture binds    %d", stats.textureBinds);
+	ImGui::Text("Uniform uploads  %d", stats.uniformUploads);
+	ImGui::Text("Bytes uploaded   %u", stats.bytesUploaded);
+	ImGui::Text("Texture uploads  %d (%u bytes)", stats.textureUploads, stats.textureBytesUploaded);
+	ImGui::Text("Text uploads     %d (%u bytes)", stats.textUploads, stats.textBytesUploaded);
+	ImGui::Text("Render thread    %.3f ms", stats.cpuMilliseconds);
+
+	ImGui::Separator();
+
+	for (int pass = 0; pass < GpuTimer::PASS_COUNT; ++pass)
+	{
+		ImGui::Text("%-10s %d draws", GpuTimer::GetPassName(static_cast<GpuPass>(pass)), stats.passDrawCalls[pass]);
+	}
+}
+
+void
+Game::DebugDrawFramePacing()
+{
+	if (!ImGui::CollapsingHeader("Frame pacing"))
+	{
+		return;
+	}
+
+	int frameCap = m_pFramePacer->GetFrameCap();
+
+	if (ImGui::SliderInt("FPS cap (0 = off)", &frameCap, 0, 240))
+	{
+		m_pFramePacer->SetFrameCap(frameCap);
+	}
+
+	int backgroundCap = m_pFramePacer->GetBackgroundFrameCap();
+
+	if (ImGui::SliderInt("Background cap", &backgroundCap, 0, 60))
+	{
+		m_pFramePacer->SetBackgroundFrameCap(backgroundCap);
+	}
+
+	int vsyncMode = static_cast<int>(m_pRenderer->GetVsyncMode());
+	bool changed = ImGui::RadioButton("Vsync off", &vsyncMode, static_cast<int>(VsyncMode::OFF));
+	ImGui::SameLine();
+	changed = ImGui::RadioButton("On", &vsyncMode, static_cast<int>(VsyncMode::ON)) || changed;
+	ImGui::SameLine();
+	changed = ImGui::RadioButton("Adaptive", &vsyncMode, static_cast<int>(VsyncMode::ADAPTIVE)) || changed;
+
+	if (changed)
+	{
+		m_pRenderer->SetVsyncMode(static_cast<VsyncMode>(vsyncMode));
+	}
+
+	// Present to present on the game thread: Present waits for the frame before, so swaps show up here too
+	float average = 0.0f;
+	float jitter = 0.0f;
+	float worst = 0.0f;
+	m_pFramePacer->GetTimings(average, jitter, worst);
+
+	ImGui::Separator();
+	ImGui::Text("Frame interval %6.3f ms", average);
+	ImGui::Text("Jitter         %6.3f ms", jitter);
+	ImGui::Text("Worst          %6.3f ms", worst);
+
+	if (m_pFramePacer->IsThrottled())
+	{
+		ImGui::Text("Throttled, the window is in the background");
+	}
+}
+
 void
 Game::ToggleDebugWindow()
 {
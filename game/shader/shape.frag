@@ -0,0 +1,10 @@
+#version 330
+
+in vec4 fragColor;
+
+out vec4 outColor;
+
+void main()
+{
+	outColor = fragColor;
+}
@@ -0,0 +1,21 @@
+#version 330
+
+// Uploaded once per frame by the Renderer, shared by every shader that declares it
+layout(std140, row_major) uniform Camera
+{
+    mat4 uViewProj;
+};
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec4 inColor;
+
+out vec4 fragColor;
+
+void main()
+{
+    vec4 pos = vec4(inPosition, 0.0, 1.0);
+
+    gl_Position = pos * uViewProj;
+
+    fragColor = inColor;
+}
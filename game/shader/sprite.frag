@@ -1,13 +1,23 @@
 #version 330
 
 in vec2 fragTexCoord;
+in vec4 fragColor;
+flat in float fragPalette;
 
 out vec4 outColor;
 
 uniform sampler2D uTexture;
-uniform vec4 color;
+uniform sampler2D uPalette;
 
 void main()
 {
-	outColor = color * texture(uTexture, fragTexCoord);
-}
\ No newline at end of file
+	vec4 texel = texture(uTexture, fragTexCoord);
+
+	// Indexed textures hold a palette index in red, the colour is in this sprite's palette row
+	if (fragPalette < 65535.0)
+	{
+		texel = texelFetch(uPalette, ivec2(int(texel.r * 255.0 + 0.5), int(fragPalette)), 0);
+	}
+
+	outColor = fragColor * texel;
+}
@@ -1,18 +1,55 @@
 #version 330
 
-uniform mat4 uWorldTransform;
-uniform mat4 uViewProj;
+// Uploaded once per frame by the Renderer, shared by every shader that declares it
+layout(std140, row_major) uniform Camera
+{
+    mat4 uViewProj;
+};
+
+// Shared unit quad
+layout(location = 0) in vec2 inCorner;
 
-layout(location = 0) in vec3 inPosition; 
-layout(location = 1) in vec2 inTexCoord;
+// Per instance
+layout(location = 1) in vec2 inPosition;
+layout(location = 2) in vec4 inSizeAngleFlip; // Half floats
+layout(location = 3) in vec4 inUVRect; // unorm16
+layout(location = 4) in vec4 inColor; // unorm8
+layout(location = 5) in float inLayer; // Only read by spritearray.frag
+layout(location = 6) in float inPalette; // Palette atlas row, 65535 when the texture is RGBA
 
 out vec2 fragTexCoord;
+out vec4 fragColor;
+flat out float fragLayer;
+flat out float fragPalette;
 
 void main()
 {
-    vec4 pos = vec4(inPosition, 1.0);
+    vec2 local = vec2(inCorner.x - 0.5, 0.5 - inCorner.y);
+
+    // Most sprites are axis aligned. The angle is the same for all four corners, so the branch
+    // doesn't diverge and unrotated sprites skip the trig.
+    float c = 1.0;
+    float s = 0.0;
+
+    if (inSizeAngleFlip.z != 0.0)
+    {
+        c = cos(inSizeAngleFlip.z);
+        s = sin(inSizeAngleFlip.z);
+    }
+
+    float flip = inSizeAngleFlip.w;
+    vec2 size = inSizeAngleFlip.xy;
+
+    vec2 world;
+    world.x = (local.x * flip * c * size.x) + (local.y * flip * s * size.y) + inPosition.x;
+    world.y = (local.x * -flip * s * size.x) + (local.y * c * size.y) + inPosition.y;
+
+    vec4 pos = vec4(world, 0.0, 1.0);
     
-    gl_Position = pos * uWorldTransform * uViewProj;
+    gl_Position = pos * uViewProj;
 
-    fragTexCoord = inTexCoord;
+    fragTexCoord = mix(inUVRect.xy, inUVRect.zw, inCorner);
+    fragColor = inColor;
+    fragLayer = inLayer;
+    fragPalette = inPalette;
 }
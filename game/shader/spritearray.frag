@@ -0,0 +1,24 @@
+#version 330
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+flat in float fragLayer;
+flat in float fragPalette;
+
+out vec4 outColor;
+
+uniform sampler2DArray uTexture;
+uniform sampler2D uPalette;
+
+void main()
+{
+	vec4 texel = texture(uTexture, vec3(fragTexCoord, fragLayer));
+
+	// Same lookup as sprite.frag
+	if (fragPalette < 65535.0)
+	{
+		texel = texelFetch(uPalette, ivec2(int(texel.r * 255.0 + 0.5), int(fragPalette)), 0);
+	}
+
+	outColor = fragColor * texel;
+}
@@ -0,0 +1,1167 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "glrenderer.h"
+
+// Local includes:
+#include "texturemanager.h"
+#include "logmanager.h"
+#include "shader.h"
+#include "spritebatch.h"
+#include "shapebatch.h"
+#include "renderqueue.h"
+#include "renderthread.h"
+#include "camera2d.h"
+#include "glstatecache.h"
+#include "sprite.h"
+#include "matrix4.h"
+#include "animatedsprite.h"
+#include "texture.h"
+#include "paletteatlas.h"
+#include "framecapture.h"
+#include "gputimer.h"
+
+// IMGUI INCLUDES
+#include "imgui/imgui_impl_sdl2.h"
+#include "imgui/imgui_impl_opengl3.h"
+
+
+// Library includes:
+#include <SDL.h>
+#include <SDL_image.h>
+#include <glew.h>
+#include <cassert>
+#include <cmath>
+
+GLRenderer::GLRenderer()
+	: m_pSpriteShader(0)
+	, m_pSpriteBatch(0)
+	, m_pSpriteArrayShader(0)
+	, m_pSpriteArrayBatch(0)
+	, m_pShapeShader(0)
+	, m_pShapeBatch(0)
+	, m_pRenderQueue(0)
+	, m_glContext(0)
+	, m_iWindowWidth(0)
+	, m_iWindowHeight(0)
+	, m_glCanvasFramebuffer(0)
+	, m_glCanvasTexture(0)
+	, m_fCanvasX(0.0f)
+	, m_fCanvasY(0.0f)
+	, m_fCanvasScale(1.0f)
+	, m_pFrameRenderQueue(0)
+	, m_iRecordingCachedLayer(-1)
+	, m_drawBlendMode(BlendMode::ALPHA)
+	, m_pWindow(nullptr)
+	, m_glCameraBuffer(0)
+	, m_glScreenBuffer(0)
+	, m_glPaletteTexture(0)
+	, m_pFrameCapture(0)
+	, m_pGpuTimer(0)
+	, m_uiLastShaderPoll(0)
+	, m_bHiddenWindow(false)
+	, m_appliedVsyncMode(VsyncMode::OFF)
+	, m_currentPass(GpuPass::CLEAR)
+	, m_pStatsMutex(0)
+{
+	m_pStatsMutex = SDL_CreateMutex();
+
+	for (int k = 0; k < RenderFrame::MAX_CACHED_LAYERS; ++k)
+	{
+		m_cachedLayers[k].glTexture = 0;
+		m_cachedLayers[k].iWidth = 0;
+		m_cachedLayers[k].iHeight = 0;
+		m_cachedLayers[k].contentKey = 0;
+		m_cachedLayers[k].bInUse = false;
+		m_cachedLayers[k].bValid = false;
+
+		m_cachedLayerFramebuffers[k] = 0;
+	}
+}
+
+GLRenderer::~GLRenderer()
+{
+	// Drains the last frame and makes the render context current here again
+	RenderThread::GetInstance().Stop();
+
+	// Reads back whatever is still in flight, so needs the render context
+	if (m_pFrameCapture)
+	{
+		m_pFrameCapture->Shutdown();
+		delete m_pFrameCapture;
+		m_pFrameCapture = 0;
+	}
+
+	if (m_pGpuTimer)
+	{
+		m_pGpuTimer->Shutdown();
+		delete m_pGpuTimer;
+		m_pGpuTimer = 0;
+	}
+
+	// IMGUI
+	ImGui_ImplOpenGL3_Shutdown();
+	ImGui_ImplSDL2_Shutdown();
+	ImGui::DestroyContext();
+
+	delete m_pSpriteShader;
+	m_pSpriteShader = 0;
+
+	delete m_pSpriteBatch;
+	m_pSpriteBatch = 0;
+
+	delete m_pSpriteArrayShader;
+	m_pSpriteArrayShader = 0;
+
+	delete m_pSpriteArrayBatch;
+	m_pSpriteArrayBatch = 0;
+
+	delete m_pShapeShader;
+	m_pShapeShader = 0;
+
+	delete m_pShapeBatch;
+	m_pShapeBatch = 0;
+
+	m_pRenderQueue = 0;
+
+	glDeleteBuffers(1, &m_glCameraBuffer);
+	m_glCameraBuffer = 0;
+
+	glDeleteBuffers(1, &m_glScreenBuffer);
+	m_glScreenBuffer = 0;
+
+	delete m_pCamera;
+	m_pCamera = 0;
+
+	glDeleteFramebuffers(1, &m_glCanvasFramebuffer);
+	m_glCanvasFramebuffer = 0;
+
+	for (int k = 0; k < RenderFrame::MAX_CACHED_LAYERS; ++k)
+	{
+		ReleaseCachedLayer(k);
+
+		glDeleteFramebuffers(1, &m_cachedLayerFramebuffers[k]);
+		m_cachedLayerFramebuffers[k] = 0;
+	}
+
+	GLStateCache::GetInstance().OnTextureDeleted(m_glCanvasTexture);
+	glDeleteTextures(1, &m_glCanvasTexture);
+	m_glCanvasTexture = 0;
+
+	delete m_pTextureManager;
+	m_pTextureManager = 0;
+
+	RenderThread::DestroyInstance();
+	GLStateCache::DestroyInstance();
+
+	SDL_DestroyMutex(m_pStatsMutex);
+	m_pStatsMutex = 0;
+
+	SDL_DestroyWindow(m_pWindow);
+	IMG_Quit();
+	SDL_Quit();
+}
+
+void GLRenderer::SetHiddenWindow(bool hidden)
+{
+	assert(m_pWindow == 0); // Must be chosen before Initialize
+	m_bHiddenWindow = hidden;
+}
+
+bool GLRenderer::Initialize(bool windowed, int width, int height)
+{
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		LogSdlError();
+		return false;
+	}
+
+	if (!windowed)
+	{
+		// Go fullscreen, with current resolution!
+		int numDisplays = SDL_GetNumVideoDisplays();
+		SDL_DisplayMode* currentDisplayMode = new SDL_DisplayMode[numDisplays];
+
+		for (int k = 0; k < numDisplays; ++k)
+		{
+			int result = SDL_GetCurrentDisplayMode(k, &currentDisplayMode[k]);
+		}
+
+		// Use the widest display?
+		int widest = 0;
+		int andItsHeight = 0;
+
+		for (int k = 0; k < numDisplays; ++k)
+		{
+			if (currentDisplayMode[k].w > widest)
+			{
+				widest = currentDisplayMode[k].w;
+				andItsHeight = currentDisplayMode[k].h;
+			}
+		}
+
+		delete[] currentDisplayMode;
+		currentDisplayMode = 0;
+
+		width = widest;
+		height = andItsHeight;
+	}
+
+	bool initialized = InitializeOpenGL(width, height);
+
+	SetFullscreen(!windowed);
+
+	if (initialized)
+	{
+		m_pTextureManager = new TextureManager();
+		assert(m_pTextureManager);
+		initialized = m_pTextureManager->Initialize();
+		m_glPaletteTexture = m_pTextureManager->GetPaletteTextureId();
+
+		// Capture is a debugging aid, the game runs without it
+		m_pFrameCapture = new FrameCapture();
+		m_pFrameCapture->Initialise();
+
+		// Queries aren't shared between contexts, so these are made here on the render context
+		m_pGpuTimer = new GpuTimer();
+		m_pGpuTimer->Initialise();
+	}
+
+	// IMGUI
+	ImGui::CreateContext();
+	ImGui_ImplSDL2_InitForOpenGL(m_pWindow, m_glContext);
+	ImGui_ImplOpenGL3_Init();
+
+	if (initialized)
+	{
+		// Create ImGui's program and font texture on the render context before handing it over
+		ImGui_ImplOpenGL3_NewFrame();
+
+		// Failing to start only costs the overlap, frames are then drawn on this thread in Present
+		RenderThread::GetInstance().Start(this, m_pWindow, m_glContext);
+	}
+
+	return initialized;
+}
+
+bool GLRenderer::InitializeOpenGL(int screenWidth, int screenHeight)
+{
+	m_iWindowWidth = screenWidth;
+	m_iWindowHeight = screenHeight;
+	m_iWidth = screenWidth;
+	m_iHeight = screenHeight;
+
+	Uint32 windowFlags = SDL_WINDOW_OPENGL;
+
+	if (m_bHiddenWindow)
+	{
+		windowFlags |= SDL_WINDOW_HIDDEN;
+	}
+
+	m_pWindow = SDL_CreateWindow("COMP710 Game Framework 2025", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, screenWidth, screenHeight, windowFlags);
+
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+
+	SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8); // Default was 8
+	SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8); // Default was 8
+	SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8); // Default was 8
+	SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8); // Default was 8
+
+	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+	SDL_GL_SetAttribute(SDL_GL_ACCELERATED_VISUAL, 1);
+
+	m_glContext = SDL_GL_CreateContext(m_pWindow);
+
+	GLenum glewResult = glewInit();
+
+	if (glewResult != GLEW_OK)
+	{
+		return false;
+	}
+
+	GLStateCache::GetInstance().Invalidate(); // Fresh context, nothing is known to be bound
+
+	// Off until the first frame asks for otherwise, see ApplyVsyncMode
+	SDL_GL_SetSwapInterval(0);
+	m_appliedVsyncMode = VsyncMode::OFF;
+
+	if (m_iInternalWidth > 0 && m_iInternalHeight > 0)
+	{
+		SetupCanvas();
+	}
+
+	SetupCameraBuffer();
+
+	bool shadersLoaded = SetupSpriteShader();
+	shadersLoaded = SetupShapeShader() && shadersLoaded;
+
+	return shadersLoaded;
+}
+
+void GLRenderer::Clear()
+{
+	RenderFrame& frame = RenderThread::GetInstance().GetRecordFrame();
+	frame.clearRed = m_fClearRed;
+	frame.clearGreen = m_fClearGreen;
+	frame.clearBlue = m_fClearBlue;
+	frame.vsyncMode = m_vsyncMode;
+
+	// Set the camera in Process: what is culled here and what is drawn must agree
+	m_pCamera->CreateViewProjection(frame.cameraViewProj);
+
+	for (int k = 0; k < RenderFrame::MAX_CACHED_LAYERS; ++k)
+	{
+		frame.cachedLayerDirty[k] = false;
+	}
+
+	m_pRenderQueue = &frame.queue;
+	m_currentLayer = RenderLayer::WORLD;
+
+	// IMGUI
+	ImGui_ImplOpenGL3_NewFrame();
+	ImGui_ImplSDL2_NewFrame();
+	ImGui::NewFrame();
+}
+
+void GLRenderer::Present()
+{
+	// IMGUI
+	ImGui::Render();
+
+	// Textures created on this thread while the frame was recorded are counted with it
+	RenderStats& uploadStats = GLStateCache::GetInstance().GetStats();
+	RenderThread::GetInstance().GetRecordFrame().uploadStats = uploadStats;
+	uploadStats.Reset();
+
+	// Returns once the previous frame is drawn, this one is drawn while the next is simulated
+	RenderThread::GetInstance().Submit(ImGui::GetDrawData());
+
+	m_pRenderQueue = 0;
+}
+
+void GLRenderer::ExecuteFrame(RenderFrame& frame)
+{
+#ifdef _DEBUG
+	// Relinked here, on the thread that owns the render context
+	ReloadChangedShaders();
+#endif
+
+	Uint64 frameStart = SDL_GetPerformanceCounter();
+
+	RenderStats& stats = GLStateCache::GetInstance().GetStats();
+	stats.Reset();
+
+	m_currentPass = GpuPass::CLEAR;
+	m_pGpuTimer->BeginFrame();
+	m_pGpuTimer->BeginPass(GpuPass::CLEAR);
+
+	UpdateCachedLayers(frame);
+
+	if (m_glCanvasFramebuffer != 0)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, m_glCanvasFramebuffer);
+		glViewport(0, 0, m_iWidth, m_iHeight);
+	}
+
+	glClearColor(frame.clearRed, frame.clearGreen, frame.clearBlue, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	UploadCameraBuffer(frame.cameraViewProj);
+
+	SubmitRenderQueue(frame.queue, true);
+
+	m_currentPass = GpuPass::PRESENT;
+	m_pGpuTimer->BeginPass(GpuPass::PRESENT);
+
+	if (m_glCanvasFramebuffer != 0)
+	{
+		PresentCanvas();
+	}
+
+	// Before ImGui, so captures show the game and not the debug UI
+	if (m_pFrameCapture)
+	{
+		m_pFrameCapture->CaptureFrame(m_glCanvasFramebuffer, m_iWidth, m_iHeight, frame.screenshotPath);
+	}
+
+	frame.screenshotPath.clear();
+
+	m_currentPass = GpuPass::IMGUI;
+	m_pGpuTimer->BeginPass(GpuPass::IMGUI);
+
+	if (frame.imguiDrawData.Valid)
+	{
+		ImGui_ImplOpenGL3_RenderDrawData(&frame.imguiDrawData);
+	}
+
+	m_pGpuTimer->EndFrame();
+
+	// ImGui binds its own program, VAO and font texture behind our back
+	GLStateCache::GetInstance().Invalidate();
+
+	// Up to the swap: the swap itself mostly waits on the GPU or vsync
+	stats.Add(frame.uploadStats);
+	stats.cpuMilliseconds = (SDL_GetPerformanceCounter() - frameStart) * 1000.0f / SDL_GetPerformanceFrequency();
+
+	SDL_LockMutex(m_pStatsMutex);
+	m_frameStats = stats;
+	SDL_UnlockMutex(m_pStatsMutex);
+
+	if (frame.vsyncMode != m_appliedVsyncMode)
+	{
+		ApplyVsyncMode(frame.vsyncMode);
+	}
+
+	SDL_GL_SwapWindow(m_pWindow);
+}
+
+void GLRenderer::ApplyVsyncMode(VsyncMode mode)
+{
+	// The swap interval belongs to the context, so this has to run where it is current
+	int interval = 0;
+
+	if (mode == VsyncMode::ON)
+	{
+		interval = 1;
+	}
+	else if (mode == VsyncMode::ADAPTIVE)
+	{
+		interval = -1;
+	}
+
+	if (SDL_GL_SetSwapInterval(interval) != 0)
+	{
+		if (mode == VsyncMode::ADAPTIVE && SDL_GL_SetSwapInterval(1) == 0)
+		{
+			LogManager::GetInstance().Log("Adaptive vsync is not supported, using vsync.");
+		}
+		else
+		{
+			LogSdlError();
+		}
+	}
+
+	// Not retried every frame when the driver refuses
+	m_appliedVsyncMode = mode;
+}
+
+void GLRenderer::SetupCanvas()
+{
+	glGenTextures(1, &m_glCanvasTexture);
+	GLStateCache::GetInstance().BindTexture(0, m_glCanvasTexture);
+
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_iInternalWidth, m_iInternalHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	glGenFramebuffers(1, &m_glCanvasFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_glCanvasFramebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_glCanvasTexture, 0);
+
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		LogManager::GetInstance().Log("Canvas framebuffer incomplete, rendering at window resolution.");
+
+		glDeleteFramebuffers(1, &m_glCanvasFramebuffer);
+		m_glCanvasFramebuffer = 0;
+
+		GLStateCache::GetInstance().OnTextureDeleted(m_glCanvasTexture);
+		glDeleteTextures(1, &m_glCanvasTexture);
+		m_glCanvasTexture = 0;
+		return;
+	}
+
+	// Everything that lays itself out with GetWidth/GetHeight now sees the canvas
+	m_iWidth = m_iInternalWidth;
+	m_iHeight = m_iInternalHeight;
+
+	// Largest whole multiple that fits keeps every art pixel the same size.
+	// A window smaller than the canvas can only be fitted with a fractional scale.
+	float fitScale = fminf(static_cast<float>(m_iWindowWidth) / m_iWidth, static_cast<float>(m_iWindowHeight) / m_iHeight);
+	m_fCanvasScale = (fitScale >= 1.0f) ? floorf(fitScale) : fitScale;
+
+	// Centred, the rest of the window is the letterbox
+	m_fCanvasX = floorf((m_iWindowWidth - m_iWidth * m_fCanvasScale) * 0.5f);
+	m_fCanvasY = floorf((m_iWindowHeight - m_iHeight * m_fCanvasScale) * 0.5f);
+}
+
+void GLRenderer::PresentCanvas()
+{
+	int x0 = static_cast<int>(m_fCanvasX);
+	int x1 = x0 + static_cast<int>(m_iWidth * m_fCanvasScale);
+
+	// GL's window origin is the bottom left, m_fCanvasY is measured from the top
+	int y1 = m_iWindowHeight - static_cast<int>(m_fCanvasY);
+	int y0 = y1 - static_cast<int>(m_iHeight * m_fCanvasScale);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(0, 0, m_iWindowWidth, m_iWindowHeight);
+
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_glCanvasFramebuffer);
+	glBlitFramebuffer(0, 0, m_iWidth, m_iHeight, x0, y0, x1, y1, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
+
+void GLRenderer::GetCanvasPlacement(float& x, float& y, float& scale) const
+{
+	x = m_fCanvasX;
+	y = m_fCanvasY;
+	scale = m_fCanvasScale;
+}
+
+void GLRenderer::SetFullscreen(bool fullscreen)
+{
+	if (fullscreen)
+	{
+		SDL_SetWindowFullscreen(m_pWindow, SDL_WINDOW_FULLSCREEN_DESKTOP | SDL_WINDOW_ALWAYS_ON_TOP);
+		SDL_SetHint(SDL_HINT_VIDEO_MINIMIZE_ON_FOCUS_LOSS, "0");
+		SDL_SetWindowSize(m_pWindow, m_iWindowWidth, m_iWindowHeight);
+	}
+	else
+	{
+		SDL_SetWindowFullscreen(m_pWindow, 0);
+	}
+}
+
+void GLRenderer::LogSdlError()
+{
+	LogManager::GetInstance().Log(SDL_GetError());
+}
+
+// Sprites
+bool GLRenderer::SetupSpriteShader()
+{
+	m_pSpriteShader = new Shader();
+
+	bool loaded = m_pSpriteShader->Load("shader/sprite.vert", "shader/sprite.frag");
+	BindShaderUniforms(*m_pSpriteShader);
+
+	m_pSpriteBatch = new SpriteBatch();
+	loaded = m_pSpriteBatch->Initialise(4096) && loaded;
+
+	// Same vertex stage, sampling the layer each instance names
+	m_pSpriteArrayShader = new Shader();
+	loaded = m_pSpriteArrayShader->Load("shader/sprite.vert", "shader/spritearray.frag") && loaded;
+	BindShaderUniforms(*m_pSpriteArrayShader);
+
+	m_pSpriteArrayBatch = new SpriteBatch();
+	loaded = m_pSpriteArrayBatch->Initialise(4096, true) && loaded;
+
+	return loaded;
+}
+
+bool GLRenderer::SetupShapeShader()
+{
+	m_pShapeShader = new Shader();
+
+	bool loaded = m_pShapeShader->Load("shader/shape.vert", "shader/shape.frag");
+	BindShaderUniforms(*m_pShapeShader);
+
+	m_pShapeBatch = new ShapeBatch();
+	loaded = m_pShapeBatch->Initialise(6144) && loaded;
+
+	return loaded;
+}
+
+void GLRenderer::BindShaderUniforms(Shader& shader)
+{
+	// Linking resets these, so they are set again whenever a shader is reloaded
+	shader.SetActive();
+	shader.BindUniformBlock("Camera", CAMERA_UNIFORM_BINDING);
+	shader.SetIntegerUniform("uPalette", PALETTE_TEXTURE_UNIT); // Ignored by programs without one
+}
+
+void GLRenderer::ReloadChangedShaders()
+{
+	// Polled, reading the few small shader files twice a second is cheaper than any file watch API
+	const unsigned int POLL_INTERVAL_MS = 500;
+	unsigned int now = SDL_GetTicks();
+
+	if (now - m_uiLastShaderPoll < POLL_INTERVAL_MS)
+	{
+		return;
+	}
+
+	m_uiLastShaderPoll = now;
+
+	Shader* shaders[3] = { m_pSpriteShader, m_pSpriteArrayShader, m_pShapeShader };
+
+	for (int k = 0; k < 3; ++k)
+	{
+		if (shaders[k] && shaders[k]->ReloadIfChanged())
+		{
+			BindShaderUniforms(*shaders[k]);
+		}
+	}
+}
+
+void GLRenderer::SetupCameraBuffer()
+{
+	m_pCamera = new Camera2D();
+	m_pCamera->SetViewportSize(static_cast<float>(m_iWidth), static_cast<float>(m_iHeight));
+	m_pCamera->SetPosition(m_iWidth * 0.5f, m_iHeight * 0.5f);
+
+	Matrix4 cameraViewProj;
+	m_pCamera->CreateViewProjection(cameraViewProj);
+
+	glGenBuffers(1, &m_glCameraBuffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, m_glCameraBuffer);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(Matrix4), &cameraViewProj, GL_DYNAMIC_DRAW);
+
+	// Screen space never moves, uploaded once
+	Matrix4 screenViewProj;
+	CreateOrthoProjection(screenViewProj, static_cast<float>(m_iWidth), static_cast<float>(m_iHeight));
+
+	glGenBuffers(1, &m_glScreenBuffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, m_glScreenBuffer);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(Matrix4), &screenViewProj, GL_STATIC_DRAW);
+
+	glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UNIFORM_BINDING, m_glCameraBuffer);
+}
+
+void GLRenderer::UploadCameraBuffer(const Matrix4& viewProj)
+{
+	// Matrix4 is row-major, matching the row_major layout of the Camera block
+	glBindBuffer(GL_UNIFORM_BUFFER, m_glCameraBuffer);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Matrix4), &viewProj);
+
+	RenderStats& stats = GLStateCache::GetInstance().GetStats();
+	++stats.uniformUploads;
+	stats.bytesUploaded += sizeof(Matrix4);
+}
+
+bool GLRenderer::IsCameraLayer(RenderLayer layer)
+{
+	return (layer == RenderLayer::WORLD || layer == RenderLayer::FX);
+}
+
+GpuPass GLRenderer::GetGpuPass(RenderLayer layer)
+{
+	switch (layer)
+	{
+	case RenderLayer::BACKGROUND:
+		return GpuPass::BACKGROUND;
+	case RenderLayer::WORLD:
+		return GpuPass::WORLD;
+	case RenderLayer::FX:
+		return GpuPass::FX;
+	default:
+		return GpuPass::HUD;
+	}
+}
+
+void GLRenderer::CreateSpriteInstance(SpriteInstance& instance, const Sprite& sprite, float sizeX, float sizeY, bool flipHorizontal)
+{
+	instance.x = static_cast<float>(sprite.GetX());
+	instance.y = static_cast<float>(sprite.GetY());
+	instance.sizeX = sizeX;
+	instance.sizeY = sizeY;
+	instance.angle = sprite.GetRotation().radians;
+	instance.flip = flipHorizontal ? -1.0f : 1.0f; // Flip horizontally by negating X scale in sprite.vert
+	instance.r = sprite.GetRedTint();
+	instance.g = sprite.GetGreenTint();
+	instance.b = sprite.GetBlueTint();
+	instance.a = sprite.GetAlpha();
+	instance.layer = 0;
+	instance.palette = sprite.GetTexture()->IsIndexed() ? sprite.GetPaletteRow() : PaletteAtlas::NO_PALETTE;
+}
+
+void GLRenderer::CaptureScreenshot(const char* pcFilename)
+{
+	// The frame being recorded, or the next one between frames: whichever Present hands over next
+	RenderThread::GetInstance().GetRecordFrame().screenshotPath = pcFilename;
+}
+
+void GLRenderer::StartRecording(const char* pcFilename, int framesPerSecond)
+{
+	if (m_pFrameCapture)
+	{
+		m_pFrameCapture->StartRecording(pcFilename, framesPerSecond);
+	}
+}
+
+void GLRenderer::StopRecording()
+{
+	if (m_pFrameCapture)
+	{
+		m_pFrameCapture->StopRecording();
+	}
+}
+
+bool GLRenderer::IsRecording() const
+{
+	return m_pFrameCapture && m_pFrameCapture->IsRecording();
+}
+
+GpuTimer* GLRenderer::GetGpuTimer()
+{
+	return m_pGpuTimer;
+}
+
+void GLRenderer::GetFrameStats(RenderStats& stats)
+{
+	SDL_LockMutex(m_pStatsMutex);
+	stats = m_frameStats;
+	SDL_UnlockMutex(m_pStatsMutex);
+}
+
+void GLRenderer::QueueSprite(unsigned int textureId, const SpriteInstance& instance, const SpriteRotation& rotation, RenderProgram program)
+{
+	if (IsCameraLayer(m_currentLayer))
+	{
+		// Bounds of the rotated quad, from the sprite's cached trig
+		float c = fabsf(rotation.cosine);
+		float s = fabsf(rotation.sine);
+		float halfWidth = 0.5f * (c * instance.sizeX + s * instance.sizeY);
+		float halfHeight = 0.5f * (s * instance.sizeX + c * instance.sizeY);
+
+		if (!m_pCamera->IsVisible(instance.x - halfWidth, instance.y - halfHeight, instance.x + halfWidth, instance.y + halfHeight))
+		{
+			return;
+		}
+	}
+
+	RenderCommand command;
+	command.program = program;
+	command.textureId = textureId;
+	command.sprite = instance;
+
+	assert(m_pRenderQueue); // Only between Clear and Present
+	m_pRenderQueue->Push(m_currentLayer, command);
+}
+
+void GLRenderer::QueueShape(ShapeType type, float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+	RenderCommand command;
+	command.program = RenderProgram::SHAPE;
+	command.textureId = 0;
+	command.shape.type = type;
+	command.shape.x1 = x1;
+	command.shape.y1 = y1;
+	command.shape.x2 = x2;
+	command.shape.y2 = y2;
+	command.shape.thickness = thickness;
+	command.shape.r = r;
+	command.shape.g = g;
+	command.shape.b = b;
+	command.shape.a = a;
+
+	assert(m_pRenderQueue); // Only between Clear and Present
+	m_pRenderQueue->Push(m_currentLayer, command);
+}
+
+void GLRenderer::SubmitRenderQueue(RenderQueue& renderQueue, bool timePasses)
+{
+	renderQueue.Sort();
+
+	const unsigned int count = renderQueue.GetCount();
+
+	GLuint boundCameraBuffer = m_glCameraBuffer;
+	glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UNIFORM_BINDING, boundCameraBuffer);
+
+	RenderProgram batchedProgram = RenderProgram::SHAPE;
+
+	for (unsigned int k = 0; k < count; ++k)
+	{
+		const RenderCommand& command = renderQueue.GetSorted(k);
+
+		if (timePasses)
+		{
+			GpuPass pass = GetGpuPass(renderQueue.GetSortedLayer(k));
+
+			// The previous pass's batches are drawn inside its own query, and counted towards it
+			if (pass != m_currentPass)
+			{
+				FlushBatches(batchedProgram);
+				m_pGpuTimer->BeginPass(pass);
+				m_currentPass = pass;
+			}
+		}
+
+		// Layers are contiguous after sorting, so this switches at most a few times a frame
+		GLuint cameraBuffer = IsCameraLayer(renderQueue.GetSortedLayer(k)) ? m_glCameraBuffer : m_glScreenBuffer;
+
+		if (cameraBuffer != boundCameraBuffer)
+		{
+			FlushBatches(batchedProgram);
+
+			glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UNIFORM_BINDING, cameraBuffer);
+			boundCameraBuffer = cameraBuffer;
+		}
+
+		SpriteBatch* pSpriteBatch = (command.program == RenderProgram::SPRITE_ARRAY) ? m_pSpriteArrayBatch : m_pSpriteBatch;
+
+		// Whatever was sorted ahead (same layer, or a lower one) must reach the GPU first
+		if (command.program != batchedProgram || pSpriteBatch->IsFull())
+		{
+			FlushBatches(batchedProgram);
+			batchedProgram = command.program;
+		}
+
+		if (command.program != RenderProgram::SHAPE)
+		{
+			pSpriteBatch->AddSprite(command.textureId, command.sprite);
+			continue;
+		}
+
+		const ShapeCommand& shape = command.shape;
+
+		switch (shape.type)
+		{
+		case ShapeType::FILLED_RECT:
+			m_pShapeBatch->AddFilledRect(shape.x1, shape.y1, shape.x2, shape.y2, shape.r, shape.g, shape.b, shape.a);
+			break;
+		case ShapeType::OUTLINED_RECT:
+			m_pShapeBatch->AddOutlinedRect(shape.x1, shape.y1, shape.x2, shape.y2, shape.thickness, shape.r, shape.g, shape.b, shape.a);
+			break;
+		case ShapeType::LINE:
+			m_pShapeBatch->AddLine(shape.x1, shape.y1, shape.x2, shape.y2, shape.thickness, shape.r, shape.g, shape.b, shape.a);
+			break;
+		}
+	}
+
+	FlushBatches(batchedProgram);
+
+	renderQueue.Clear();
+}
+
+void GLRenderer::FlushBatches(RenderProgram program)
+{
+	GLStateCache& stateCache = GLStateCache::GetInstance();
+	RenderStats& stats = stateCache.GetStats();
+
+	// Cached layers hold premultiplied colour, everything else is straight alpha
+	BlendMode blendMode = (program == RenderProgram::COMPOSITE) ? BlendMode::PREMULTIPLIED : m_drawBlendMode;
+
+	if (m_pShapeBatch && !m_pShapeBatch->IsEmpty())
+	{
+		m_pShapeShader->SetActive();
+		stateCache.SetBlendMode(blendMode);
+
+		m_pShapeBatch->Flush();
+		stats.passDrawCalls[static_cast<int>(m_currentPass)] += m_pShapeBatch->GetLastFlushDrawCalls();
+	}
+
+	if ((m_pSpriteBatch && !m_pSpriteBatch->IsEmpty()) || (m_pSpriteArrayBatch && !m_pSpriteArrayBatch->IsEmpty()))
+	{
+		// Shared by both sprite programs, only sampled for indexed textures
+		stateCache.BindTexture(PALETTE_TEXTURE_UNIT, m_glPaletteTexture);
+	}
+
+	if (m_pSpriteBatch && !m_pSpriteBatch->IsEmpty())
+	{
+		m_pSpriteShader->SetActive();
+		stateCache.SetBlendMode(blendMode);
+
+		m_pSpriteBatch->Flush();
+		stats.passDrawCalls[static_cast<int>(m_currentPass)] += m_pSpriteBatch->GetLastFlushDrawCalls();
+	}
+
+	if (m_pSpriteArrayBatch && !m_pSpriteArrayBatch->IsEmpty())
+	{
+		m_pSpriteArrayShader->SetActive();
+		stateCache.SetBlendMode(blendMode);
+
+		m_pSpriteArrayBatch->Flush();
+		stats.passDrawCalls[static_cast<int>(m_currentPass)] += m_pSpriteArrayBatch->GetLastFlushDrawCalls();
+	}
+}
+
+int GLRenderer::AcquireCachedLayer()
+{
+	for (int k = 0; k < RenderFrame::MAX_CACHED_LAYERS; ++k)
+	{
+		CachedLayer& layer = m_cachedLayers[k];
+
+		if (!layer.bInUse)
+		{
+			layer.bInUse = true;
+			layer.bValid = false;
+			return k;
+		}
+	}
+
+	LogManager::GetInstance().Log("No free cached layers, drawing uncached.");
+	return -1;
+}
+
+void GLRenderer::ReleaseCachedLayer(int cachedLayer)
+{
+	if (cachedLayer < 0)
+	{
+		return;
+	}
+
+	assert(cachedLayer < RenderFrame::MAX_CACHED_LAYERS);
+	CachedLayer& layer = m_cachedLayers[cachedLayer];
+
+	RenderThread::GetInstance().DeleteTexture(layer.glTexture);
+	layer.glTexture = 0;
+	layer.iWidth = 0;
+	layer.iHeight = 0;
+	layer.bValid = false;
+	layer.bInUse = false;
+}
+
+bool GLRenderer::BeginCachedLayer(int cachedLayer, unsigned int contentKey)
+{
+	assert(m_iRecordingCachedLayer == -1);
+	assert(m_pRenderQueue); // Only between Clear and Present
+
+	if (cachedLayer < 0)
+	{
+		// Out of cached layers: callers draw straight into the frame every time
+		return true;
+	}
+
+	assert(cachedLayer < RenderFrame::MAX_CACHED_LAYERS);
+	assert(!IsCameraLayer(m_currentLayer)); // Cached in screen space
+
+	CachedLayer& layer = m_cachedLayers[cachedLayer];
+	assert(layer.bInUse);
+
+	bool sizeChanged = (layer.iWidth != m_iWidth || layer.iHeight != m_iHeight);
+
+	if (layer.bValid && !sizeChanged && layer.contentKey == contentKey)
+	{
+		return false;
+	}
+
+	if (sizeChanged)
+	{
+		CreateCachedLayerTexture(layer);
+	}
+
+	layer.contentKey = contentKey;
+	layer.bValid = true;
+
+	RenderFrame& frame = RenderThread::GetInstance().GetRecordFrame();
+	frame.cachedLayerDirty[cachedLayer] = true;
+	frame.cachedLayerTextures[cachedLayer] = layer.glTexture;
+	frame.cachedLayerQueues[cachedLayer].Clear();
+
+	m_pFrameRenderQueue = m_pRenderQueue;
+	m_pRenderQueue = &frame.cachedLayerQueues[cachedLayer];
+	m_iRecordingCachedLayer = cachedLayer;
+
+	return true;
+}
+
+void GLRenderer::EndCachedLayer()
+{
+	if (m_iRecordingCachedLayer == -1)
+	{
+		return; // Uncached fallback from BeginCachedLayer
+	}
+
+	m_pRenderQueue = m_pFrameRenderQueue;
+	m_pFrameRenderQueue = 0;
+	m_iRecordingCachedLayer = -1;
+}
+
+void GLRenderer::DrawCachedLayer(int cachedLayer)
+{
+	assert(m_iRecordingCachedLayer == -1);
+
+	if (cachedLayer < 0)
+	{
+		return;
+	}
+
+	assert(cachedLayer < RenderFrame::MAX_CACHED_LAYERS);
+	const CachedLayer& layer = m_cachedLayers[cachedLayer];
+
+	if (!layer.bValid)
+	{
+		return;
+	}
+
+	// One quad over the whole canvas. The framebuffer's first row is the bottom of the screen,
+	// which is where sprite.vert puts (u0, v0) of an unrotated quad.
+	RenderCommand command;
+	command.program = RenderProgram::COMPOSITE;
+	command.textureId = layer.glTexture;
+	command.sprite.x = m_iWidth * 0.5f;
+	command.sprite.y = m_iHeight * 0.5f;
+	command.sprite.sizeX = static_cast<float>(m_iWidth);
+	command.sprite.sizeY = static_cast<float>(m_iHeight);
+	command.sprite.angle = 0.0f;
+	command.sprite.flip = 1.0f;
+	SpriteUVRect uvs = { 0.0f, 0.0f, 1.0f, 1.0f };
+	command.sprite.uvs = uvs;
+	command.sprite.r = 1.0f;
+	command.sprite.g = 1.0f;
+	command.sprite.b = 1.0f;
+	command.sprite.a = 1.0f;
+	command.sprite.layer = 0;
+	command.sprite.palette = PaletteAtlas::NO_PALETTE;
+
+	m_pRenderQueue->Push(m_currentLayer, command);
+}
+
+void GLRenderer::CreateCachedLayerTexture(CachedLayer& layer)
+{
+	RenderThread::GetInstance().DeleteTexture(layer.glTexture);
+
+	glGenTextures(1, &layer.glTexture);
+	GLStateCache::GetInstance().BindTexture(0, layer.glTexture);
+
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_iWidth, m_iHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	RenderThread::GetInstance().OnTextureUploaded();
+
+	layer.iWidth = m_iWidth;
+	layer.iHeight = m_iHeight;
+}
+
+void GLRenderer::UpdateCachedLayers(RenderFrame& frame)
+{
+	bool updated = false;
+
+	for (int k = 0; k < RenderFrame::MAX_CACHED_LAYERS; ++k)
+	{
+		if (!frame.cachedLayerDirty[k])
+		{
+			continue;
+		}
+
+		// Framebuffers aren't shared between contexts, so these only exist on the render thread
+		GLuint& framebuffer = m_cachedLayerFramebuffers[k];
+
+		if (framebuffer == 0)
+		{
+			glGenFramebuffers(1, &framebuffer);
+		}
+
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, frame.cachedLayerTextures[k], 0);
+		glViewport(0, 0, m_iWidth, m_iHeight);
+
+		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+
+		m_drawBlendMode = BlendMode::ALPHA_TO_LAYER;
+		SubmitRenderQueue(frame.cachedLayerQueues[k]);
+		m_drawBlendMode = BlendMode::ALPHA;
+
+		frame.cachedLayerDirty[k] = false;
+		updated = true;
+	}
+
+	if (updated)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, m_iWindowWidth, m_iWindowHeight);
+	}
+}
+
+void GLRenderer::DrawSprite(Sprite& sprite, bool flipHorizontal)
+{
+	SpriteInstance instance;
+	CreateSpriteInstance(instance, sprite
+		, static_cast<float>(sprite.GetWidth())
+		, static_cast<float>(sprite.GetHeight())
+		, flipHorizontal);
+
+	// The whole texture, which for an atlas region is only part of its page
+	const Texture* pTexture = sprite.GetTexture();
+	SpriteUVRect uvs = { pTexture->MapU(0.0f), pTexture->MapV(0.0f), pTexture->MapU(1.0f), pTexture->MapV(1.0f) };
+	instance.uvs = uvs;
+
+	QueueSprite(pTexture->GetTextureId(), instance, sprite.GetRotation());
+}
+
+// -----------------------------------------------------------Draw Animated Sprites-------------------------------------------------
+
+void
+GLRenderer::DrawAnimatedSprite(AnimatedSprite& sprite, int frame, bool flipHorizontal)
+{
+	const FrameTable& frameTable = sprite.GetFrameTable();
+	const FrameTrim& trim = frameTable.trims[frame];
+
+	if (trim.width == 0)
+	{
+		// Nothing visible in this frame
+		return;
+	}
+
+	// Screen pixels per sheet pixel
+	const float scaleX = static_cast<float>(sprite.GetWidth()) / frameTable.frameWidth;
+	const float scaleY = static_cast<float>(sprite.GetHeight()) / frameTable.frameHeight;
+
+	SpriteInstance instance;
+	CreateSpriteInstance(instance, sprite
+		, trim.width * scaleX
+		, trim.height * scaleY
+		, flipHorizontal);
+
+	// Move the trimmed quad's centre to where it sat in the full frame, through the same
+	// flip and rotation sprite.vert applies to the quad's corners
+	const float offsetX = ((trim.x + trim.width * 0.5f) - frameTable.frameWidth * 0.5f) * scaleX;
+	const float offsetY = ((trim.y + trim.height * 0.5f) - frameTable.frameHeight * 0.5f) * scaleY;
+	const SpriteRotation& rotation = sprite.GetRotation();
+
+	if (rotation.bRotated)
+	{
+		const float c = rotation.cosine;
+		const float s = rotation.sine;
+
+		instance.x += (offsetX * instance.flip * c) + (offsetY * instance.flip * s);
+		instance.y += (offsetX * -instance.flip * s) + (offsetY * c);
+	}
+	else
+	{
+		// Axis aligned: the cosine is 1 or -1 and the sine 0
+		instance.x += offsetX * instance.flip * rotation.cosine;
+		instance.y += offsetY * rotation.cosine;
+	}
+
+	if (frameTable.arrayTextureId != 0)
+	{
+		// Each layer is one whole frame, oriented the same way BuildFrameTable cuts them from a sheet
+		SpriteUVRect uvs;
+		uvs.u0 = static_cast<float>(trim.x) / frameTable.frameWidth;
+		uvs.v0 = static_cast<float>(trim.y + trim.height) / frameTable.frameHeight;
+		uvs.u1 = static_cast<float>(trim.x + trim.width) / frameTable.frameWidth;
+		uvs.v1 = static_cast<float>(trim.y) / frameTable.frameHeight;
+		instance.uvs = uvs;
+		instance.layer = static_cast<unsigned int>(frameTable.firstLayer + frame);
+
+		if (!frameTable.bArrayIndexed)
+		{
+			instance.palette = PaletteAtlas::NO_PALETTE;
+		}
+
+		QueueSprite(frameTable.arrayTextureId, instance, rotation, RenderProgram::SPRITE_ARRAY);
+		return;
+	}
+
+	instance.uvs = sprite.GetFrameUVs(frame);
+
+	QueueSprite(sprite.GetTexture()->GetTextureId(), instance, rotation);
+}
+
+void GLRenderer::DrawFilledRect(float x1, float y1, float x2, float y2, unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+	QueueShape(ShapeType::FILLED_RECT, x1, y1, x2, y2, 0.0f, r, g, b, a);
+}
+
+void GLRenderer::DrawOutlinedRect(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+	QueueShape(ShapeType::OUTLINED_RECT, x1, y1, x2, y2, thickness, r, g, b, a);
+}
+
+void GLRenderer::DrawLine(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+	QueueShape(ShapeType::LINE, x1, y1, x2, y2, thickness, r, g, b, a);
+}
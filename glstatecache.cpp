@@ -0,0 +1,179 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "glstatecache.h"
+
+// Local includes:
+
+// Library includes:
+#include <glew.h>
+#include <cassert>
+
+// Static Members:
+thread_local GLStateCache* GLStateCache::sm_pInstance = 0;
+
+GLStateCache& GLStateCache::GetInstance()
+{
+	if (sm_pInstance == 0)
+	{
+		sm_pInstance = new GLStateCache();
+	}
+	return (*sm_pInstance);
+}
+
+void GLStateCache::DestroyInstance()
+{
+	delete sm_pInstance;
+	sm_pInstance = 0;
+}
+
+GLStateCache::GLStateCache()
+{
+	Invalidate();
+}
+
+GLStateCache::~GLStateCache()
+{
+
+}
+
+void GLStateCache::UseProgram(unsigned int program)
+{
+	if (m_program != program)
+	{
+		glUseProgram(program);
+		m_program = program;
+		++m_stats.programSwitches;
+	}
+}
+
+void GLStateCache::BindVertexArray(unsigned int vertexArray)
+{
+	if (m_vertexArray != vertexArray)
+	{
+		glBindVertexArray(vertexArray);
+		m_vertexArray = vertexArray;
+	}
+}
+
+void GLStateCache::BindTexture(unsigned int unit, unsigned int texture)
+{
+	assert(unit < MAX_TEXTURE_UNITS);
+
+	if (m_textures[unit] == texture)
+	{
+		return;
+	}
+
+	if (m_activeTextureUnit != unit)
+	{
+		glActiveTexture(GL_TEXTURE0 + unit);
+		m_activeTextureUnit = unit;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, texture);
+	m_textures[unit] = texture;
+	++m_stats.textureBinds;
+}
+
+void GLStateCache::BindTextureArray(unsigned int unit, unsigned int texture)
+{
+	assert(unit < MAX_TEXTURE_UNITS);
+
+	if (m_textureArrays[unit] == texture)
+	{
+		return;
+	}
+
+	if (m_activeTextureUnit != unit)
+	{
+		glActiveTexture(GL_TEXTURE0 + unit);
+		m_activeTextureUnit = unit;
+	}
+
+	glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+	m_textureArrays[unit] = texture;
+	++m_stats.textureBinds;
+}
+
+void GLStateCache::SetBlendMode(BlendMode mode)
+{
+	if (m_blendMode == mode)
+	{
+		return;
+	}
+
+	if (mode == BlendMode::ALPHA)
+	{
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+	else if (mode == BlendMode::ALPHA_TO_LAYER)
+	{
+		// Compositing the layer later with PREMULTIPLIED matches drawing its content directly
+		glEnable(GL_BLEND);
+		glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	}
+	else if (mode == BlendMode::PREMULTIPLIED)
+	{
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	}
+	else
+	{
+		glDisable(GL_BLEND);
+	}
+
+	m_blendMode = mode;
+}
+
+void GLStateCache::OnProgramDeleted(unsigned int program)
+{
+	if (m_program == program)
+	{
+		m_program = UNKNOWN_BINDING;
+	}
+}
+
+void GLStateCache::OnVertexArrayDeleted(unsigned int vertexArray)
+{
+	if (m_vertexArray == vertexArray)
+	{
+		m_vertexArray = 0;
+	}
+}
+
+void GLStateCache::OnTextureDeleted(unsigned int texture)
+{
+	for (unsigned int k = 0; k < MAX_TEXTURE_UNITS; ++k)
+	{
+		if (m_textures[k] == texture)
+		{
+			m_textures[k] = 0;
+		}
+
+		if (m_textureArrays[k] == texture)
+		{
+			m_textureArrays[k] = 0;
+		}
+	}
+}
+
+void GLStateCache::Invalidate()
+{
+	m_program = UNKNOWN_BINDING;
+	m_vertexArray = UNKNOWN_BINDING;
+	m_activeTextureUnit = UNKNOWN_BINDING;
+	m_blendMode = BlendMode::UNKNOWN;
+
+	for (unsigned int k = 0; k < MAX_TEXTURE_UNITS; ++k)
+	{
+		m_textures[k] = UNKNOWN_BINDING;
+		m_textureArrays[k] = UNKNOWN_BINDING;
+	}
+}
+
+RenderStats& GLStateCache::GetStats()
+{
+	return m_stats;
+}
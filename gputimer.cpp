@@ -0,0 +1,265 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "gputimer.h"
+
+// Local includes:
+#include "logmanager.h"
+
+// Library includes:
+#include <cassert>
+
+GpuTimer::GpuTimer()
+	: m_iCurrentSet(0)
+	, m_iActivePass(-1)
+	, m_bTiming(false)
+	, m_bInitialised(false)
+	, m_iHistoryNext(0)
+	, m_iHistoryCount(0)
+	, m_pMutex(0)
+{
+	for (int k = 0; k < QUERY_FRAMES; ++k)
+	{
+		QuerySet& querySet = m_querySets[k];
+		querySet.lastPass = -1;
+		querySet.bPending = false;
+
+		for (int pass = 0; pass < PASS_COUNT; ++pass)
+		{
+			querySet.queries[pass] = 0;
+			querySet.used[pass] = false;
+		}
+	}
+
+	for (int pass = 0; pass < PASS_COUNT; ++pass)
+	{
+		m_averages[pass] = 0.0f;
+	}
+}
+
+GpuTimer::~GpuTimer()
+{
+	assert(!m_bInitialised); // Shutdown needs the render context
+}
+
+bool GpuTimer::Initialise()
+{
+	// Core since 3.3, which is what we ask for, but drivers have been known to leave it out
+	if (!GLEW_VERSION_3_3 && !GLEW_ARB_timer_query)
+	{
+		LogManager::GetInstance().Log("GPU timer: no timer queries, GPU time will not be shown.");
+		return false;
+	}
+
+	for (int k = 0; k < QUERY_FRAMES; ++k)
+	{
+		glGenQueries(PASS_COUNT, m_querySets[k].queries);
+	}
+
+	m_pMutex = SDL_CreateMutex();
+	m_bInitialised = true;
+
+	return true;
+}
+
+void GpuTimer::Shutdown()
+{
+	if (!m_bInitialised)
+	{
+		return;
+	}
+
+	for (int k = 0; k < QUERY_FRAMES; ++k)
+	{
+		glDeleteQueries(PASS_COUNT, m_querySets[k].queries);
+	}
+
+	SDL_DestroyMutex(m_pMutex);
+	m_pMutex = 0;
+
+	m_bInitialised = false;
+}
+
+void GpuTimer::BeginFrame()
+{
+	m_bTiming = false;
+
+	if (!m_bInitialised)
+	{
+		return;
+	}
+
+	m_iCurrentSet = (m_iCurrentSet + 1) % QUERY_FRAMES;
+	QuerySet& querySet = m_querySets[m_iCurrentSet];
+
+	// Still running QUERY_FRAMES later means the GPU is badly behind: skip a frame rather than wait
+	if (querySet.bPending && !ReadBack(querySet))
+	{
+		return;
+	}
+
+	for (int pass = 0; pass < PASS_COUNT; ++pass)
+	{
+		querySet.used[pass] = false;
+	}
+
+	querySet.lastPass = -1;
+	m_bTiming = true;
+}
+
+void GpuTimer::BeginPass(GpuPass pass)
+{
+	if (!m_bTiming)
+	{
+		return;
+	}
+
+	const int passIndex = static_cast<int>(pass);
+
+	if (passIndex == m_iActivePass)
+	{
+		return;
+	}
+
+	QuerySet& querySet = m_querySets[m_iCurrentSet];
+
+	if (m_iActivePass != -1)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		m_iActivePass = -1;
+	}
+
+	// One query per pass per frame: a pass that comes round again is left untimed
+	if (querySet.used[passIndex])
+	{
+		return;
+	}
+
+	glBeginQuery(GL_TIME_ELAPSED, querySet.queries[passIndex]);
+	querySet.used[passIndex] = true;
+	querySet.lastPass = passIndex;
+	m_iActivePass = passIndex;
+}
+
+void GpuTimer::EndFrame()
+{
+	if (!m_bTiming)
+	{
+		return;
+	}
+
+	if (m_iActivePass != -1)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		m_iActivePass = -1;
+	}
+
+	QuerySet& querySet = m_querySets[m_iCurrentSet];
+	querySet.bPending = (querySet.lastPass != -1);
+
+	m_bTiming = false;
+}
+
+bool GpuTimer::ReadBack(QuerySet& querySet)
+{
+	// Queries complete in the order they were issued, so the last one stands for all of them
+	GLuint available = 0;
+	glGetQueryObjectuiv(querySet.queries[querySet.lastPass], GL_QUERY_RESULT_AVAILABLE, &available);
+
+	if (available == 0)
+	{
+		return false;
+	}
+
+	float* pFrame = m_history[m_iHistoryNext];
+
+	for (int pass = 0; pass < PASS_COUNT; ++pass)
+	{
+		pFrame[pass] = 0.0f;
+
+		if (querySet.used[pass])
+		{
+			GLuint64 nanoseconds = 0;
+			glGetQueryObjectui64v(querySet.queries[pass], GL_QUERY_RESULT, &nanoseconds);
+			pFrame[pass] = nanoseconds / 1000000.0f;
+		}
+	}
+
+	querySet.bPending = false;
+
+	m_iHistoryNext = (m_iHistoryNext + 1) % HISTORY_FRAMES;
+
+	if (m_iHistoryCount < HISTORY_FRAMES)
+	{
+		++m_iHistoryCount;
+	}
+
+	float averages[PASS_COUNT];
+
+	for (int pass = 0; pass < PASS_COUNT; ++pass)
+	{
+		float total = 0.0f;
+
+		for (int k = 0; k < m_iHistoryCount; ++k)
+		{
+			total += m_history[k][pass];
+		}
+
+		averages[pass] = total / m_iHistoryCount;
+	}
+
+	SDL_LockMutex(m_pMutex);
+
+	for (int pass = 0; pass < PASS_COUNT; ++pass)
+	{
+		m_averages[pass] = averages[pass];
+	}
+
+	SDL_UnlockMutex(m_pMutex);
+
+	return true;
+}
+
+void GpuTimer::GetAverages(float (&milliseconds)[PASS_COUNT]) const
+{
+	if (!m_bInitialised)
+	{
+		for (int pass = 0; pass < PASS_COUNT; ++pass)
+		{
+			milliseconds[pass] = 0.0f;
+		}
+		return;
+	}
+
+	SDL_LockMutex(m_pMutex);
+
+	for (int pass = 0; pass < PASS_COUNT; ++pass)
+	{
+		milliseconds[pass] = m_averages[pass];
+	}
+
+	SDL_UnlockMutex(m_pMutex);
+}
+
+const char* GpuTimer::GetPassName(GpuPass pass)
+{
+	switch (pass)
+	{
+	case GpuPass::CLEAR:
+		return "Clear";
+	case GpuPass::BACKGROUND:
+		return "Background";
+	case GpuPass::WORLD:
+		return "World";
+	case GpuPass::FX:
+		return "FX";
+	case GpuPass::HUD:
+		return "HUD";
+	case GpuPass::IMGUI:
+		return "ImGui";
+	case GpuPass::PRESENT:
+		return "Present";
+	default:
+		return "?";
+	}
+}
@@ -21,6 +21,10 @@ InputSystem::InputSystem()
 	, m_pXboxController(0)
 	, m_iNumAttachedControllers(0)
 	, m_bRelativeMouseMode(false)
+	, m_fMouseCanvasX(0.0f)
+	, m_fMouseCanvasY(0.0f)
+	, m_fMouseCanvasScale(1.0f)
+	, m_bWindowFocused(true)
 	, m_previousKeyBoardState()
 {
 
@@ -90,7 +94,14 @@ InputSystem::ProcessInput()
 		m_currentMouseButtons = SDL_GetMouseState(&mouseX, &mouseY);
 	}
 
-	m_mousePosition.Set(static_cast<float>(mouseX), static_cast<float>(mouseY));
+	if (m_bRelativeMouseMode)
+	{
+		m_mousePosition.Set(static_cast<float>(mouseX), static_cast<float>(mouseY));
+	}
+	else
+	{
+		m_mousePosition.Set((mouseX - m_fMouseCanvasX) / m_fMouseCanvasScale, (mouseY - m_fMouseCanvasY) / m_fMouseCanvasScale);
+	}
 
 	for (int k = 0; k < m_iNumAttachedControllers; ++k)
 	{
@@ -102,7 +113,24 @@ InputSystem::ProcessInput()
 	{
 		ImGuiIO& io = ImGui::GetIO();
 
-		ImGui_ImplSDL2_ProcessEvent(&event);
+		// No platform backend without a window (NullRenderer)
+		if (io.BackendPlatformUserData != nullptr)
+		{
+			ImGui_ImplSDL2_ProcessEvent(&event);
+		}
+
+		// Before ImGui can swallow the event, focus matters even with the debug window up
+		if (event.type == SDL_WINDOWEVENT)
+		{
+			if (event.window.event == SDL_WINDOWEVENT_FOCUS_GAINED)
+			{
+				m_bWindowFocused = true;
+			}
+			else if (event.window.event == SDL_WINDOWEVENT_FOCUS_LOST)
+			{
+				m_bWindowFocused = false;
+			}
+		}
 
 		// Cursor be hidden or not
 		//io.ConfigFlags |= ImGuiConfigFlags_NoMouseCursorChange;
@@ -234,6 +262,20 @@ InputSystem::SetRelativeMode(bool relative)
 	m_bRelativeMouseMode = relative;
 }
 
+void
+InputSystem::SetMouseCanvas(float x, float y, float scale)
+{
+	m_fMouseCanvasX = x;
+	m_fMouseCanvasY = y;
+	m_fMouseCanvasScale = scale;
+}
+
+bool
+InputSystem::IsWindowFocused() const
+{
+	return m_bWindowFocused;
+}
+
 int
 InputSystem::GetNumberOfControllersAttached() const
 {
@@ -2,10 +2,15 @@
 
 // Library includes:
 #include <SDL.h>
+#include <cstring>
+#include <cstdlib>
 
 // Local includes:
 #include "Game.h"
+#include "renderer.h"
 #include "logmanager.h"
+#include "atlaspacker.h"
+#include "renderharness.h"
 
 int main(int argc, char* argv[])
 {
@@ -14,8 +19,62 @@ int main(int argc, char* argv[])
 	_CrtSetBreakAlloc(165);
 #endif
 
+	// Build step: repack the texture atlas instead of running the game
+	if (argc > 1 && strcmp(argv[1], "-buildatlas") == 0)
+	{
+		int result = AtlasPacker::RunBuildStep();
+		LogManager::DestroyInstance();
+		return result;
+	}
+
+	// Offscreen render regression test and benchmark, -update replaces the golden images
+	if (argc > 1 && strcmp(argv[1], "-renderharness") == 0)
+	{
+		bool updateGolden = (argc > 2 && strcmp(argv[2], "-update") == 0);
+		int result = RenderHarness::RunBuildStep(updateGolden);
+		LogManager::DestroyInstance();
+		return result;
+	}
+
+	// Soak test / simulation benchmark: no window or GL, optionally stopping after a number of frames
+	GameRunMode runMode = GameRunMode::PLAY;
+	int frameLimit = 0;
+	if (argc > 1 && strcmp(argv[1], "-nullrenderer") == 0)
+	{
+		runMode = GameRunMode::NULL_RENDERER;
+		if (argc > 2)
+		{
+			frameLimit = atoi(argv[2]);
+		}
+	}
+
 	Game& gameInstance = Game::GetInstance();
-	if (!gameInstance.Initialise())
+	gameInstance.SetFrameLimit(frameLimit);
+
+	// Frame pacing: -fpscap <frames per second> and -vsync off|on|adaptive, vsync on and no cap otherwise
+	for (int k = 1; k + 1 < argc; ++k)
+	{
+		if (strcmp(argv[k], "-fpscap") == 0)
+		{
+			gameInstance.SetFrameCap(atoi(argv[k + 1]));
+		}
+		else if (strcmp(argv[k], "-vsync") == 0)
+		{
+			if (strcmp(argv[k + 1], "off") == 0)
+			{
+				gameInstance.SetVsyncMode(VsyncMode::OFF);
+			}
+			else if (strcmp(argv[k + 1], "adaptive") == 0)
+			{
+				gameInstance.SetVsyncMode(VsyncMode::ADAPTIVE);
+			}
+			else
+			{
+				gameInstance.SetVsyncMode(VsyncMode::ON);
+			}
+		}
+	}
+	if (!gameInstance.Initialise(runMode))
 	{
 		LogManager::GetInstance().Log("Game initialize failed!");
 		Game::DestroyInstance();
@@ -46,4 +46,22 @@ void CreateOrthoProjection(Matrix4& mat, float width, float height)
 	mat.m[3][1] = 1.0f;
 	mat.m[3][2] = 0.0f;
 	mat.m[3][3] = 1.0f;
-}
\ No newline at end of file
+}
+
+// Y down, (left, top) maps to the top left of the viewport
+void CreateOrthoProjection(Matrix4& mat, float left, float top, float right, float bottom)
+{
+	SetZero(mat);
+
+	float width = right - left;
+	float height = bottom - top;
+
+	mat.m[0][0] = 2.0f / width;
+	mat.m[1][1] = 2.0f / -height;
+	mat.m[2][2] = -2.0f / (1.0f - -1.0f);
+
+	mat.m[3][0] = -(right + left) / width;
+	mat.m[3][1] = (bottom + top) / height;
+	mat.m[3][2] = 0.0f;
+	mat.m[3][3] = 1.0f;
+}
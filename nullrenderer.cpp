@@ -0,0 +1,228 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "nullrenderer.h"
+
+// Local includes:
+#include "texturemanager.h"
+#include "texture.h"
+#include "camera2d.h"
+#include "renderthread.h"
+#include "renderstats.h"
+#include "logmanager.h"
+#include "imgui/imgui.h"
+
+// Library includes:
+#include <SDL_image.h>
+#include <cassert>
+
+NullRenderer::NullRenderer()
+	: m_cachedLayers(RenderFrame::MAX_CACHED_LAYERS)
+{
+	for (int k = 0; k < RenderFrame::MAX_CACHED_LAYERS; ++k)
+	{
+		m_cachedLayers[k].contentKey = 0;
+		m_cachedLayers[k].bInUse = false;
+		m_cachedLayers[k].bValid = false;
+	}
+}
+
+NullRenderer::~NullRenderer()
+{
+	delete m_pTextureManager;
+	m_pTextureManager = 0;
+
+	delete m_pCamera;
+	m_pCamera = 0;
+
+	ImGui::DestroyContext();
+
+	// Texture destructors hand their (zero) names to it, which it ignores
+	RenderThread::DestroyInstance();
+
+	Texture::SetHeadless(false);
+
+	IMG_Quit();
+	SDL_Quit();
+}
+
+bool NullRenderer::Initialize(bool /*windowed*/, int width, int height)
+{
+	// No video: events and timers only, so input polling and SDL_GetTicks still work
+	if (SDL_Init(SDL_INIT_EVENTS | SDL_INIT_TIMER) < 0)
+	{
+		LogManager::GetInstance().Log(SDL_GetError());
+		return false;
+	}
+
+	Texture::SetHeadless(true);
+
+	m_iWidth = (m_iInternalWidth > 0) ? m_iInternalWidth : width;
+	m_iHeight = (m_iInternalHeight > 0) ? m_iInternalHeight : height;
+
+	m_pCamera = new Camera2D();
+	m_pCamera->SetViewportSize(static_cast<float>(m_iWidth), static_cast<float>(m_iHeight));
+	m_pCamera->SetPosition(m_iWidth * 0.5f, m_iHeight * 0.5f);
+
+	m_pTextureManager = new TextureManager();
+	assert(m_pTextureManager);
+	bool initialized = m_pTextureManager->Initialize();
+
+	// The debug window still builds its draw lists, only they are never drawn. ImGui wants
+	// a built font atlas before its first frame, the pixels are simply thrown away.
+	ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+	io.DisplaySize = ImVec2(static_cast<float>(m_iWidth), static_cast<float>(m_iHeight));
+
+	unsigned char* pPixels = 0;
+	int fontWidth = 0;
+	int fontHeight = 0;
+	io.Fonts->GetTexDataAsRGBA32(&pPixels, &fontWidth, &fontHeight);
+
+	if (initialized)
+	{
+		LogManager::GetInstance().Log("Null renderer initialised, nothing will be drawn.");
+	}
+
+	return initialized;
+}
+
+void NullRenderer::Clear()
+{
+	m_currentLayer = RenderLayer::WORLD;
+
+	ImGuiIO& io = ImGui::GetIO();
+	io.DisplaySize = ImVec2(static_cast<float>(m_iWidth), static_cast<float>(m_iHeight));
+	io.DeltaTime = 1.0f / 60.0f;
+	ImGui::NewFrame();
+}
+
+void NullRenderer::Present()
+{
+	ImGui::Render();
+}
+
+void NullRenderer::GetCanvasPlacement(float& x, float& y, float& scale) const
+{
+	x = 0.0f;
+	y = 0.0f;
+	scale = 1.0f;
+}
+
+void NullRenderer::DrawSprite(Sprite& /*sprite*/, bool /*FlipHorizontal*/)
+{
+
+}
+
+void NullRenderer::DrawAnimatedSprite(AnimatedSprite& /*sprite*/, int /*frame*/, bool /*FlipHorizontal*/)
+{
+
+}
+
+void NullRenderer::DrawFilledRect(float /*x1*/, float /*y1*/, float /*x2*/, float /*y2*/, unsigned char /*r*/, unsigned char /*g*/, unsigned char /*b*/, unsigned char /*a*/)
+{
+
+}
+
+void NullRenderer::DrawOutlinedRect(float /*x1*/, float /*y1*/, float /*x2*/, float /*y2*/, float /*thickness*/, unsigned char /*r*/, unsigned char /*g*/, unsigned char /*b*/, unsigned char /*a*/)
+{
+
+}
+
+void NullRenderer::DrawLine(float /*x1*/, float /*y1*/, float /*x2*/, float /*y2*/, float /*thickness*/, unsigned char /*r*/, unsigned char /*g*/, unsigned char /*b*/, unsigned char /*a*/)
+{
+
+}
+
+int NullRenderer::AcquireCachedLayer()
+{
+	for (int k = 0; k < RenderFrame::MAX_CACHED_LAYERS; ++k)
+	{
+		CachedLayer& layer = m_cachedLayers[k];
+
+		if (!layer.bInUse)
+		{
+			layer.bInUse = true;
+			layer.bValid = false;
+			return k;
+		}
+	}
+
+	LogManager::GetInstance().Log("No free cached layers, drawing uncached.");
+	return -1;
+}
+
+void NullRenderer::ReleaseCachedLayer(int cachedLayer)
+{
+	if (cachedLayer < 0)
+	{
+		return;
+	}
+
+	assert(cachedLayer < RenderFrame::MAX_CACHED_LAYERS);
+	CachedLayer& layer = m_cachedLayers[cachedLayer];
+	layer.bValid = false;
+	layer.bInUse = false;
+}
+
+bool NullRenderer::BeginCachedLayer(int cachedLayer, unsigned int contentKey)
+{
+	if (cachedLayer < 0)
+	{
+		return true;
+	}
+
+	assert(cachedLayer < RenderFrame::MAX_CACHED_LAYERS);
+	CachedLayer& layer = m_cachedLayers[cachedLayer];
+	assert(layer.bInUse);
+
+	if (layer.bValid && layer.contentKey == contentKey)
+	{
+		return false;
+	}
+
+	layer.contentKey = contentKey;
+	layer.bValid = true;
+
+	return true;
+}
+
+void NullRenderer::EndCachedLayer()
+{
+
+}
+
+void NullRenderer::DrawCachedLayer(int /*cachedLayer*/)
+{
+
+}
+
+void NullRenderer::CaptureScreenshot(const char* /*pcFilename*/)
+{
+	LogManager::GetInstance().Log("Null renderer: nothing to capture.");
+}
+
+void NullRenderer::StartRecording(const char* /*pcFilename*/, int /*framesPerSecond*/)
+{
+	LogManager::GetInstance().Log("Null renderer: nothing to record.");
+}
+
+void NullRenderer::StopRecording()
+{
+
+}
+
+bool NullRenderer::IsRecording() const
+{
+	return false;
+}
+
+GpuTimer* NullRenderer::GetGpuTimer()
+{
+	return 0;
+}
+
+void NullRenderer::GetFrameStats(RenderStats& stats)
+{
+	stats.Reset();
+}
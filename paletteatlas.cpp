@@ -0,0 +1,128 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "paletteatlas.h"
+
+// Local includes:
+#include "glstatecache.h"
+#include "renderthread.h"
+
+// Library includes:
+#include <glew.h>
+#include <cassert>
+#include <cstring>
+#include <map>
+
+PaletteAtlas::PaletteAtlas()
+	: m_uiTextureId(0)
+	, m_numPalettes(0)
+{
+}
+
+PaletteAtlas::~PaletteAtlas()
+{
+	RenderThread::GetInstance().DeleteTexture(m_uiTextureId);
+	m_uiTextureId = 0;
+}
+
+bool PaletteAtlas::Initialise()
+{
+	glGenTextures(1, &m_uiTextureId);
+	GLStateCache::GetInstance().BindTexture(0, m_uiTextureId);
+
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, PALETTE_SIZE, MAX_PALETTES, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+
+	// Only ever read with texelFetch, but an incomplete texture samples black
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	return (m_uiTextureId != 0);
+}
+
+unsigned int PaletteAtlas::AddPalette(const std::vector<unsigned int>& colours)
+{
+	assert(colours.size() <= PALETTE_SIZE);
+
+	if (IsFull())
+	{
+		return NO_PALETTE;
+	}
+
+	unsigned int row[PALETTE_SIZE] = {};
+	memcpy(row, colours.data(), colours.size() * sizeof(unsigned int));
+
+	GLStateCache::GetInstance().BindTexture(0, m_uiTextureId);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, m_numPalettes, PALETTE_SIZE, 1, GL_RGBA, GL_UNSIGNED_BYTE, row);
+	GLStateCache::GetInstance().GetStats().AddTextureUpload(sizeof(row));
+
+	RenderThread::GetInstance().OnTextureUploaded();
+
+	return m_numPalettes++;
+}
+
+bool PaletteAtlas::IsFull() const
+{
+	return (m_numPalettes >= MAX_PALETTES);
+}
+
+unsigned int PaletteAtlas::GetTextureId() const
+{
+	return (m_uiTextureId);
+}
+
+bool PaletteAtlas::IndexPixels(const unsigned char* pPixels, int width, int height, int pitch
+	, std::vector<unsigned int>& palette, std::vector<unsigned char>& indices)
+{
+	std::map<unsigned int, unsigned char> lookup;
+
+	palette.clear();
+	indices.resize(static_cast<size_t>(width) * height);
+
+	// Pixel art repeats colours along a row, so most lookups are the previous pixel's
+	unsigned int lastColour = 0;
+	unsigned char lastIndex = 0;
+	bool bHasLast = false;
+
+	for (int y = 0; y < height; ++y)
+	{
+		const unsigned char* pRow = pPixels + (y * pitch);
+
+		for (int x = 0; x < width; ++x)
+		{
+			unsigned int colour = 0;
+
+			if (pRow[x * 4 + 3] != 0)
+			{
+				memcpy(&colour, &pRow[x * 4], sizeof(colour));
+			}
+
+			if (!bHasLast || colour != lastColour)
+			{
+				std::map<unsigned int, unsigned char>::iterator iter = lookup.find(colour);
+
+				if (iter == lookup.end())
+				{
+					if (palette.size() >= PALETTE_SIZE)
+					{
+						return false;
+					}
+
+					lastIndex = static_cast<unsigned char>(palette.size());
+					lookup[colour] = lastIndex;
+					palette.push_back(colour);
+				}
+				else
+				{
+					lastIndex = iter->second;
+				}
+
+				lastColour = colour;
+				bHasLast = true;
+			}
+
+			indices[static_cast<size_t>(y) * width + x] = lastIndex;
+		}
+	}
+
+	return true;
+}
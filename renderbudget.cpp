@@ -0,0 +1,226 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "renderbudget.h"
+
+// Local includes:
+#include "logmanager.h"
+
+// Library includes:
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+RenderBudget::RenderBudget()
+	: m_iWarmupFrames(0)
+{
+
+}
+
+RenderBudget::~RenderBudget()
+{
+
+}
+
+bool RenderBudget::Load(const char* pcFilename)
+{
+	std::ifstream budgetFile(pcFilename);
+
+	if (!budgetFile.is_open())
+	{
+		LogManager::GetInstance().Log("Render budget: file not found!");
+		return false;
+	}
+
+	bool loaded = true;
+	std::string line;
+
+	while (std::getline(budgetFile, line))
+	{
+		// Tolerate Windows line endings and trailing spaces
+		while (!line.empty() && (line[line.size() - 1] == '\r' || line[line.size() - 1] == ' '))
+		{
+			line.erase(line.size() - 1);
+		}
+
+		if (line.empty() || line[0] == '#')
+		{
+			continue;
+		}
+
+		std::istringstream fields(line);
+		std::string name;
+		long long limit = -1;
+		fields >> name >> limit;
+
+		if (fields.fail() || limit < 0)
+		{
+			LogManager::GetInstance().Log(("Render budget: bad line " + line).c_str());
+			loaded = false;
+			continue;
+		}
+
+		if (name == "warmup_frames")
+		{
+			m_iWarmupFrames = static_cast<int>(limit);
+			continue;
+		}
+
+		loaded = SetLimit(name, static_cast<unsigned int>(limit)) && loaded;
+	}
+
+	return loaded;
+}
+
+bool RenderBudget::SetLimit(const std::string& name, unsigned int limit)
+{
+	unsigned int value = 0;
+
+	if (!GetStat(RenderStats(), name, value))
+	{
+		LogManager::GetInstance().Log(("Render budget: no stat called " + name).c_str());
+		return false;
+	}
+
+	for (size_t k = 0; k < m_limits.size(); ++k)
+	{
+		if (m_limits[k].name == name)
+		{
+			m_limits[k].limit = limit;
+			return true;
+		}
+	}
+
+	Limit newLimit;
+	newLimit.name = name;
+	newLimit.limit = limit;
+	m_limits.push_back(newLimit);
+
+	return true;
+}
+
+int RenderBudget::GetWarmupFrames() const
+{
+	return m_iWarmupFrames;
+}
+
+bool RenderBudget::IsEmpty() const
+{
+	return m_limits.empty();
+}
+
+bool RenderBudget::Check(const RenderStats& stats, int frame, std::string& failures) const
+{
+	bool withinBudget = true;
+
+	for (size_t k = 0; k < m_limits.size(); ++k)
+	{
+		const Limit& limit = m_limits[k];
+
+		unsigned int value = 0;
+		GetStat(stats, limit.name, value);
+
+		if (value > limit.limit)
+		{
+			std::ostringstream failure;
+			failure << "Frame " << frame << ": " << limit.name << " " << value << " over budget of " << limit.limit << "\n";
+			failures += failure.str();
+
+			withinBudget = false;
+		}
+	}
+
+	return withinBudget;
+}
+
+void RenderBudget::GetStatNames(std::vector<std::string>& names)
+{
+	names.clear();
+	names.push_back("draw_calls");
+	names.push_back("triangles");
+	names.push_back("program_switches");
+	names.push_back("texture_binds");
+	names.push_back("uniform_uploads");
+	names.push_back("bytes_uploaded");
+	names.push_back("texture_uploads");
+	names.push_back("texture_bytes_uploaded");
+	names.push_back("text_uploads");
+	names.push_back("text_bytes_uploaded");
+
+	for (int pass = 0; pass < GpuTimer::PASS_COUNT; ++pass)
+	{
+		names.push_back(GetPassStatName(static_cast<GpuPass>(pass)));
+	}
+}
+
+std::string RenderBudget::GetPassStatName(GpuPass pass)
+{
+	// The pass name in lower case, e.g. hud_draw_calls
+	std::string passName = GpuTimer::GetPassName(pass);
+
+	for (size_t c = 0; c < passName.size(); ++c)
+	{
+		passName[c] = static_cast<char>(tolower(static_cast<unsigned char>(passName[c])));
+	}
+
+	return passName + "_draw_calls";
+}
+
+bool RenderBudget::GetStat(const RenderStats& stats, const std::string& name, unsigned int& value)
+{
+	if (name == "draw_calls")
+	{
+		value = stats.drawCalls;
+	}
+	else if (name == "triangles")
+	{
+		value = stats.triangles;
+	}
+	else if (name == "program_switches")
+	{
+		value = stats.programSwitches;
+	}
+	else if (name == "texture_binds")
+	{
+		value = stats.textureBinds;
+	}
+	else if (name == "uniform_uploads")
+	{
+		value = stats.uniformUploads;
+	}
+	else if (name == "bytes_uploaded")
+	{
+		value = stats.bytesUploaded;
+	}
+	else if (name == "texture_uploads")
+	{
+		value = stats.textureUploads;
+	}
+	else if (name == "texture_bytes_uploaded")
+	{
+		value = stats.textureBytesUploaded;
+	}
+	else if (name == "text_uploads")
+	{
+		value = stats.textUploads;
+	}
+	else if (name == "text_bytes_uploaded")
+	{
+		value = stats.textBytesUploaded;
+	}
+	else
+	{
+		for (int pass = 0; pass < GpuTimer::PASS_COUNT; ++pass)
+		{
+			if (name == GetPassStatName(static_cast<GpuPass>(pass)))
+			{
+				value = stats.passDrawCalls[pass];
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,437 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "renderharness.h"
+
+// Local includes:
+#include "game.h"
+#include "glrenderer.h"
+#include "logmanager.h"
+
+// Library includes:
+#include <SDL.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <direct.h>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+RenderHarness::RenderHarness()
+	: m_iMissingGoldens(0)
+	, m_iFramesOverBudget(0)
+	, m_iFramesRun(0)
+	, m_fWallSeconds(0.0f)
+	, m_fGameTimeTotal(0.0f)
+	, m_fGameTimeMax(0.0f)
+	, m_fRenderTimeTotal(0.0f)
+	, m_fRenderTimeMax(0.0f)
+	, m_iDrawCallsTotal(0)
+	, m_iDrawCallsMax(0)
+{
+
+}
+
+RenderHarness::~RenderHarness()
+{
+
+}
+
+bool RenderHarness::LoadScript(const char* pcScriptFilename)
+{
+	std::ifstream scriptFile(pcScriptFilename);
+
+	if (!scriptFile.is_open())
+	{
+		LogManager::GetInstance().Log("Render harness: script not found!");
+		return false;
+	}
+
+	m_scriptedFrames.clear();
+	std::string line;
+
+	while (std::getline(scriptFile, line))
+	{
+		// Tolerate Windows line endings and trailing spaces
+		while (!line.empty() && (line[line.size() - 1] == '\r' || line[line.size() - 1] == ' '))
+		{
+			line.erase(line.size() - 1);
+		}
+
+		if (line.empty() || line[0] == '#')
+		{
+			continue;
+		}
+
+		int frame = atoi(line.c_str());
+
+		if (frame <= 0)
+		{
+			LogManager::GetInstance().Log(("Render harness: bad frame number " + line).c_str());
+			return false;
+		}
+
+		m_scriptedFrames.push_back(frame);
+	}
+
+	std::sort(m_scriptedFrames.begin(), m_scriptedFrames.end());
+	m_scriptedFrames.erase(std::unique(m_scriptedFrames.begin(), m_scriptedFrames.end()), m_scriptedFrames.end());
+
+	if (m_scriptedFrames.empty())
+	{
+		LogManager::GetInstance().Log("Render harness: script lists no frames!");
+		return false;
+	}
+
+	return true;
+}
+
+bool RenderHarness::LoadBudget(const char* pcBudgetFilename)
+{
+	return m_budget.Load(pcBudgetFilename);
+}
+
+bool RenderHarness::Run(const char* pcCaptureDirectory)
+{
+	assert(!m_scriptedFrames.empty());
+
+	// Same spawns and drops every run, the fixed step does the rest
+	srand(1);
+
+	Game& game = Game::GetInstance();
+
+	if (!game.Initialise(GameRunMode::RENDER_HARNESS))
+	{
+		LogManager::GetInstance().Log("Render harness: game failed to initialise!");
+		Game::DestroyInstance();
+		return false;
+	}
+
+	GLRenderer* pRenderer = static_cast<GLRenderer*>(game.GetRenderer());
+
+	const int lastFrame = m_scriptedFrames.back();
+	const float millisecondsPerCount = 1000.0f / SDL_GetPerformanceFrequency();
+	size_t nextCapture = 0;
+
+	Uint64 runStart = SDL_GetPerformanceCounter();
+
+	for (int frame = 1; frame <= lastFrame; ++frame)
+	{
+		// Recorded into the frame this DoGameLoop draws, so the capture is always of that frame
+		if (nextCapture < m_scriptedFrames.size() && m_scriptedFrames[nextCapture] == frame)
+		{
+			pRenderer->CaptureScreenshot(GetFramePath(pcCaptureDirectory, frame).c_str());
+			++nextCapture;
+		}
+
+		Uint64 frameStart = SDL_GetPerformanceCounter();
+
+		if (!game.DoGameLoop())
+		{
+			LogManager::GetInstance().Log("Render harness: the game quit before the last scripted frame!");
+			break;
+		}
+
+		// Includes waiting for the render thread to take the frame, so it is the game thread's frame time
+		float gameTime = (SDL_GetPerformanceCounter() - frameStart) * millisecondsPerCount;
+
+		// The render thread is a frame behind: these belong to the frame before
+		RenderStats stats;
+		pRenderer->GetFrameStats(stats);
+
+		float renderTime = stats.cpuMilliseconds;
+		int drawCalls = stats.drawCalls;
+
+		if (frame > m_budget.GetWarmupFrames())
+		{
+			m_peakStats.Max(stats);
+
+			if (!m_budget.Check(stats, frame - 1, m_budgetFailures))
+			{
+				++m_iFramesOverBudget;
+			}
+		}
+
+		m_fGameTimeTotal += gameTime;
+		m_fGameTimeMax = std::max(m_fGameTimeMax, gameTime);
+		m_fRenderTimeTotal += renderTime;
+		m_fRenderTimeMax = std::max(m_fRenderTimeMax, renderTime);
+		m_iDrawCallsTotal += drawCalls;
+		m_iDrawCallsMax = std::max(m_iDrawCallsMax, drawCalls);
+
+		++m_iFramesRun;
+	}
+
+	m_fWallSeconds = (SDL_GetPerformanceCounter() - runStart) * millisecondsPerCount / 1000.0f;
+
+	// Drains the render thread and the capture writer, so every capture is on disk after this
+	Game::DestroyInstance();
+
+	return m_iFramesRun == lastFrame;
+}
+
+int RenderHarness::Compare(const char* pcCaptureDirectory, const char* pcGoldenDirectory)
+{
+	m_results.clear();
+
+	int failures = 0;
+	m_iMissingGoldens = 0;
+
+	for (size_t k = 0; k < m_scriptedFrames.size(); ++k)
+	{
+		FrameResult result;
+		result.frame = m_scriptedFrames[k];
+		result.hash = 0;
+		result.goldenHash = 0;
+		result.differingPixels = 0;
+		result.bCaptured = false;
+		result.bHasGolden = false;
+		result.bMatch = false;
+
+		int width = 0;
+		int height = 0;
+		std::vector<unsigned char> pixels;
+
+		result.bCaptured = LoadPixels(GetFramePath(pcCaptureDirectory, result.frame), width, height, pixels);
+
+		if (result.bCaptured)
+		{
+			result.hash = HashPixels(pixels);
+		}
+
+		int goldenWidth = 0;
+		int goldenHeight = 0;
+		std::vector<unsigned char> goldenPixels;
+
+		if (pcGoldenDirectory != 0)
+		{
+			result.bHasGolden = LoadPixels(GetFramePath(pcGoldenDirectory, result.frame), goldenWidth, goldenHeight, goldenPixels);
+		}
+
+		if (result.bHasGolden)
+		{
+			result.goldenHash = HashPixels(goldenPixels);
+		}
+
+		if (result.bCaptured && result.bHasGolden)
+		{
+			if (result.hash == result.goldenHash)
+			{
+				result.bMatch = true;
+			}
+			else if (width == goldenWidth && height == goldenHeight)
+			{
+				// Different hardware rarely matches bit for bit, so allow a few pixels to be a little off
+				for (size_t p = 0; p < pixels.size(); p += 4)
+				{
+					for (int c = 0; c < 4; ++c)
+					{
+						if (abs(pixels[p + c] - goldenPixels[p + c]) > CHANNEL_TOLERANCE)
+						{
+							++result.differingPixels;
+							break;
+						}
+					}
+				}
+
+				long long allowed = static_cast<long long>(width) * height * MAX_DIFFERING_PIXELS_PER_MILLION / 1000000;
+				result.bMatch = (result.differingPixels <= allowed);
+			}
+			else
+			{
+				result.differingPixels = width * height;
+			}
+		}
+
+		// Without a golden directory the run is just hashing what it captured. A frame with no golden
+		// is counted on its own, the build step fails on it so a missing image can't pass the gate.
+		bool passed = result.bCaptured && (pcGoldenDirectory == 0 || !result.bHasGolden || result.bMatch);
+
+		if (!passed)
+		{
+			++failures;
+		}
+
+		if (pcGoldenDirectory != 0 && result.bCaptured && !result.bHasGolden)
+		{
+			++m_iMissingGoldens;
+		}
+
+		m_results.push_back(result);
+	}
+
+	return failures;
+}
+
+bool RenderHarness::WriteReport(const char* pcFilename) const
+{
+	std::ostringstream report;
+	report << std::fixed << std::setprecision(3);
+
+	float frames = static_cast<float>(std::max(m_iFramesRun, 1));
+
+	report << "Render harness: " << m_iFramesRun << " frames in " << m_fWallSeconds << "s, "
+		<< (m_iFramesRun / std::max(m_fWallSeconds, 0.001f)) << " frames per second\n";
+	report << "Game thread ms per frame: average " << (m_fGameTimeTotal / frames) << ", worst " << m_fGameTimeMax << "\n";
+	report << "Render thread ms per frame: average " << (m_fRenderTimeTotal / frames) << ", worst " << m_fRenderTimeMax << "\n";
+	report << "Draw calls per frame: average " << (m_iDrawCallsTotal / frames) << ", worst " << m_iDrawCallsMax << "\n";
+
+	if (m_iMissingGoldens > 0)
+	{
+		report << "Frames without a golden image, failed: " << m_iMissingGoldens << "\n";
+	}
+
+	// What to set budget.txt from, the worst of every stat once the scene has loaded
+	report << "Worst frame after " << m_budget.GetWarmupFrames() << " warmup frames:\n";
+
+	std::vector<std::string> statNames;
+	RenderBudget::GetStatNames(statNames);
+
+	for (size_t k = 0; k < statNames.size(); ++k)
+	{
+		unsigned int value = 0;
+		RenderBudget::GetStat(m_peakStats, statNames[k], value);
+		report << "  " << statNames[k] << " " << value << "\n";
+	}
+
+	if (m_budget.IsEmpty())
+	{
+		report << "WARNING: the budget sets no limits, no frame was checked against it\n";
+	}
+	else
+	{
+		report << "Frames over budget: " << m_iFramesOverBudget << "\n" << m_budgetFailures;
+	}
+
+	for (size_t k = 0; k < m_results.size(); ++k)
+	{
+		const FrameResult& result = m_results[k];
+
+		report << "Frame " << std::setw(4) << std::setfill('0') << result.frame << std::setfill(' ') << ": ";
+
+		if (!result.bCaptured)
+		{
+			report << "NOT CAPTURED\n";
+			continue;
+		}
+
+		report << "hash " << std::hex << std::setw(16) << std::setfill('0') << result.hash << std::dec << std::setfill(' ');
+
+		if (!result.bHasGolden)
+		{
+			report << ", NO GOLDEN, FAIL, run -renderharness -update\n";
+			continue;
+		}
+
+		report << ", golden " << std::hex << std::setw(16) << std::setfill('0') << result.goldenHash << std::dec << std::setfill(' ')
+			<< ", " << result.differingPixels << " pixels differ, " << (result.bMatch ? "PASS" : "FAIL") << "\n";
+	}
+
+	std::string text = report.str();
+	LogManager::GetInstance().Log(text.c_str());
+
+	std::ofstream reportFile(pcFilename, std::ios::trunc);
+
+	if (!reportFile.is_open())
+	{
+		LogManager::GetInstance().Log("Render harness: failed to write the report!");
+		return false;
+	}
+
+	reportFile << text;
+	return true;
+}
+
+int RenderHarness::RunBuildStep(bool updateGolden)
+{
+	RenderHarness harness;
+
+	if (!harness.LoadScript("assets/golden/script.txt"))
+	{
+		return 1;
+	}
+
+	// Updating writes the captures straight over the goldens
+	const char* pcCaptureDirectory = updateGolden ? "assets/golden" : "harness";
+	_mkdir("harness");
+
+	if (!harness.LoadBudget("assets/golden/budget.txt"))
+	{
+		return 1;
+	}
+
+	bool ran = harness.Run(pcCaptureDirectory);
+	int failures = harness.Compare(pcCaptureDirectory, updateGolden ? 0 : "assets/golden");
+
+	harness.WriteReport("harness/report.txt");
+
+	// Updating the goldens is not the time to enforce budgets, or to expect goldens to be there
+	if (!updateGolden)
+	{
+		failures += harness.m_iMissingGoldens;
+		failures += harness.m_iFramesOverBudget;
+	}
+
+	// The renderer shut SDL down already, loading the images started SDL_image again
+	IMG_Quit();
+	SDL_Quit();
+
+	return (ran && failures == 0) ? 0 : 1;
+}
+
+std::string RenderHarness::GetFramePath(const char* pcDirectory, int frame)
+{
+	std::ostringstream path;
+	path << pcDirectory << "/frame_" << std::setw(4) << std::setfill('0') << frame << ".png";
+	return path.str();
+}
+
+bool RenderHarness::LoadPixels(const std::string& path, int& width, int& height, std::vector<unsigned char>& pixels)
+{
+	SDL_Surface* pLoaded = IMG_Load(path.c_str());
+
+	if (pLoaded == 0)
+	{
+		return false;
+	}
+
+	SDL_Surface* pSurface = SDL_ConvertSurfaceFormat(pLoaded, SDL_PIXELFORMAT_RGBA32, 0);
+	SDL_FreeSurface(pLoaded);
+
+	if (pSurface == 0)
+	{
+		return false;
+	}
+
+	width = pSurface->w;
+	height = pSurface->h;
+
+	// Tightly packed, rows may be padded in the surface
+	const size_t rowBytes = static_cast<size_t>(width) * 4;
+	pixels.resize(rowBytes * height);
+
+	for (int y = 0; y < height; ++y)
+	{
+		const unsigned char* pRow = static_cast<const unsigned char*>(pSurface->pixels) + static_cast<size_t>(y) * pSurface->pitch;
+		std::copy(pRow, pRow + rowBytes, pixels.begin() + rowBytes * y);
+	}
+
+	SDL_FreeSurface(pSurface);
+	return true;
+}
+
+unsigned long long RenderHarness::HashPixels(const std::vector<unsigned char>& pixels)
+{
+	// 64 bit FNV-1a
+	unsigned long long hash = 14695981039346656037ULL;
+
+	for (size_t k = 0; k < pixels.size(); ++k)
+	{
+		hash ^= pixels[k];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
@@ -0,0 +1,128 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "renderqueue.h"
+
+// Library includes:
+#include <cassert>
+#include <cstddef>
+
+RenderQueue::RenderQueue()
+	: m_nextOrder(0)
+	, m_bSorted(true)
+{
+	m_commands.reserve(1024);
+	m_entries.reserve(1024);
+	m_scratch.reserve(1024);
+}
+
+RenderQueue::~RenderQueue()
+{
+
+}
+
+uint64_t RenderQueue::MakeSortKey(RenderLayer layer, RenderProgram program, unsigned int textureId, unsigned int order)
+{
+	assert(textureId <= 0xFFFF);
+
+	return (static_cast<uint64_t>(layer) << 56)
+		| (static_cast<uint64_t>(program) << 48)
+		| (static_cast<uint64_t>(textureId & 0xFFFF) << 32)
+		| static_cast<uint64_t>(order);
+}
+
+void RenderQueue::Push(RenderLayer layer, const RenderCommand& command)
+{
+	SortEntry entry;
+	entry.key = MakeSortKey(layer, command.program, command.textureId, m_nextOrder++);
+	entry.commandIndex = static_cast<unsigned int>(m_commands.size());
+
+	m_commands.push_back(command);
+	m_entries.push_back(entry);
+
+	m_bSorted = false;
+}
+
+void RenderQueue::Sort()
+{
+	if (m_bSorted)
+	{
+		return;
+	}
+
+	const size_t count = m_entries.size();
+	m_scratch.resize(count);
+
+	// One pass over the keys builds the histograms for all eight bytes
+	size_t histograms[8][256] = {};
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		uint64_t key = m_entries[i].key;
+
+		for (int byte = 0; byte < 8; ++byte)
+		{
+			++histograms[byte][(key >> (byte * 8)) & 0xFF];
+		}
+	}
+
+	// LSD radix sort, least significant byte first
+	for (int byte = 0; byte < 8; ++byte)
+	{
+		size_t* histogram = histograms[byte];
+		const int shift = byte * 8;
+
+		// Every key shares this byte (typically layer, program or the high order bits), nothing to move
+		if (histogram[(m_entries[0].key >> shift) & 0xFF] == count)
+		{
+			continue;
+		}
+
+		size_t offset = 0;
+		for (int bucket = 0; bucket < 256; ++bucket)
+		{
+			size_t bucketCount = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += bucketCount;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const SortEntry& entry = m_entries[i];
+			m_scratch[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+		}
+
+		m_entries.swap(m_scratch);
+	}
+
+	m_bSorted = true;
+}
+
+void RenderQueue::Clear()
+{
+	m_commands.clear();
+	m_entries.clear();
+	m_nextOrder = 0;
+	m_bSorted = true;
+}
+
+unsigned int RenderQueue::GetCount() const
+{
+	return static_cast<unsigned int>(m_entries.size());
+}
+
+const RenderCommand& RenderQueue::GetSorted(unsigned int index) const
+{
+	assert(m_bSorted);
+	assert(index < m_entries.size());
+
+	return m_commands[m_entries[index].commandIndex];
+}
+
+RenderLayer RenderQueue::GetSortedLayer(unsigned int index) const
+{
+	assert(m_bSorted);
+	assert(index < m_entries.size());
+
+	return static_cast<RenderLayer>(m_entries[index].key >> 56);
+}
@@ -0,0 +1,87 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "renderstats.h"
+
+// Library includes:
+#include <algorithm>
+
+RenderStats::RenderStats()
+{
+	Reset();
+}
+
+void RenderStats::Reset()
+{
+	drawCalls = 0;
+	triangles = 0;
+	programSwitches = 0;
+	textureBinds = 0;
+	uniformUploads = 0;
+	bytesUploaded = 0;
+	textureUploads = 0;
+	textureBytesUploaded = 0;
+	textUploads = 0;
+	textBytesUploaded = 0;
+
+	for (int pass = 0; pass < GpuTimer::PASS_COUNT; ++pass)
+	{
+		passDrawCalls[pass] = 0;
+	}
+
+	cpuMilliseconds = 0.0f;
+}
+
+void RenderStats::Add(const RenderStats& stats)
+{
+	drawCalls += stats.drawCalls;
+	triangles += stats.triangles;
+	programSwitches += stats.programSwitches;
+	textureBinds += stats.textureBinds;
+	uniformUploads += stats.uniformUploads;
+	bytesUploaded += stats.bytesUploaded;
+	textureUploads += stats.textureUploads;
+	textureBytesUploaded += stats.textureBytesUploaded;
+	textUploads += stats.textUploads;
+	textBytesUploaded += stats.textBytesUploaded;
+
+	for (int pass = 0; pass < GpuTimer::PASS_COUNT; ++pass)
+	{
+		passDrawCalls[pass] += stats.passDrawCalls[pass];
+	}
+
+	cpuMilliseconds += stats.cpuMilliseconds;
+}
+
+void RenderStats::Max(const RenderStats& stats)
+{
+	drawCalls = std::max(drawCalls, stats.drawCalls);
+	triangles = std::max(triangles, stats.triangles);
+	programSwitches = std::max(programSwitches, stats.programSwitches);
+	textureBinds = std::max(textureBinds, stats.textureBinds);
+	uniformUploads = std::max(uniformUploads, stats.uniformUploads);
+	bytesUploaded = std::max(bytesUploaded, stats.bytesUploaded);
+	textureUploads = std::max(textureUploads, stats.textureUploads);
+	textureBytesUploaded = std::max(textureBytesUploaded, stats.textureBytesUploaded);
+	textUploads = std::max(textUploads, stats.textUploads);
+	textBytesUploaded = std::max(textBytesUploaded, stats.textBytesUploaded);
+
+	for (int pass = 0; pass < GpuTimer::PASS_COUNT; ++pass)
+	{
+		passDrawCalls[pass] = std::max(passDrawCalls[pass], stats.passDrawCalls[pass]);
+	}
+
+	cpuMilliseconds = std::max(cpuMilliseconds, stats.cpuMilliseconds);
+}
+
+void RenderStats::AddTextureUpload(unsigned int bytes)
+{
+	++textureUploads;
+	textureBytesUploaded += bytes;
+}
+
+void RenderStats::AddTextUpload(unsigned int bytes)
+{
+	++textUploads;
+	textBytesUploaded += bytes;
+}
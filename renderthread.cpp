@@ -0,0 +1,332 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "renderthread.h"
+
+// Local includes:
+#include "glrenderer.h"
+#include "glstatecache.h"
+#include "logmanager.h"
+
+// Library includes:
+#include <cassert>
+
+// Static Members:
+RenderThread* RenderThread::sm_pInstance = 0;
+
+RenderThread& RenderThread::GetInstance()
+{
+	if (sm_pInstance == 0)
+	{
+		sm_pInstance = new RenderThread();
+	}
+	return (*sm_pInstance);
+}
+
+void RenderThread::DestroyInstance()
+{
+	delete sm_pInstance;
+	sm_pInstance = 0;
+}
+
+RenderThread::RenderThread()
+	: m_pRenderer(0)
+	, m_pWindow(0)
+	, m_renderContext(0)
+	, m_loaderContext(0)
+	, m_pThread(0)
+	, m_pMutex(0)
+	, m_pFrameReady(0)
+	, m_pFrameDone(0)
+	, m_iRecordFrame(0)
+	, m_pPendingFrame(0)
+	, m_bQuit(false)
+	, m_bRunning(false)
+	, m_bTexturesUploaded(false)
+{
+	for (int k = 0; k < 2; ++k)
+	{
+		m_frames[k].clearRed = 0.0f;
+		m_frames[k].clearGreen = 0.0f;
+		m_frames[k].clearBlue = 0.0f;
+		m_frames[k].vsyncMode = VsyncMode::OFF;
+		m_frames[k].uploadFence = 0;
+
+		for (int layer = 0; layer < RenderFrame::MAX_CACHED_LAYERS; ++layer)
+		{
+			m_frames[k].cachedLayerDirty[layer] = false;
+			m_frames[k].cachedLayerTextures[layer] = 0;
+		}
+	}
+}
+
+RenderThread::~RenderThread()
+{
+	Stop();
+
+	for (int k = 0; k < 2; ++k)
+	{
+		FreeDrawData(m_frames[k].imguiDrawData);
+	}
+}
+
+bool RenderThread::Start(GLRenderer* pRenderer, SDL_Window* pWindow, SDL_GLContext renderContext)
+{
+	assert(!m_bRunning);
+
+	m_pRenderer = pRenderer;
+	m_pWindow = pWindow;
+	m_renderContext = renderContext;
+
+	// Created while the render context is current, so textures made on it are visible to both
+	SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+	m_loaderContext = SDL_GL_CreateContext(m_pWindow);
+
+	if (m_loaderContext == 0)
+	{
+		LogManager::GetInstance().Log("Render thread: failed to create the loader context, rendering on the game thread.");
+		return false;
+	}
+
+	// The render context must not be current here when the render thread takes it
+	SDL_GL_MakeCurrent(m_pWindow, m_loaderContext);
+
+	// This thread's state cache now shadows the loader context
+	GLStateCache::GetInstance().Invalidate();
+
+	m_pMutex = SDL_CreateMutex();
+	m_pFrameReady = SDL_CreateCond();
+	m_pFrameDone = SDL_CreateCond();
+
+	m_bQuit = false;
+	m_pPendingFrame = 0;
+	m_pThread = SDL_CreateThread(RenderThreadMain, "Render", this);
+
+	if (m_pThread == 0)
+	{
+		LogManager::GetInstance().Log("Render thread: failed to start, rendering on the game thread.");
+
+		SDL_GL_MakeCurrent(m_pWindow, m_renderContext);
+		SDL_GL_DeleteContext(m_loaderContext);
+		m_loaderContext = 0;
+		GLStateCache::GetInstance().Invalidate();
+		return false;
+	}
+
+	m_bRunning = true;
+
+	return true;
+}
+
+void RenderThread::Stop()
+{
+	if (!m_bRunning)
+	{
+		return;
+	}
+
+	SDL_LockMutex(m_pMutex);
+	m_bQuit = true;
+	SDL_CondSignal(m_pFrameReady);
+	SDL_UnlockMutex(m_pMutex);
+
+	SDL_WaitThread(m_pThread, 0);
+	m_pThread = 0;
+	m_bRunning = false;
+
+	SDL_DestroyCond(m_pFrameReady);
+	SDL_DestroyCond(m_pFrameDone);
+	SDL_DestroyMutex(m_pMutex);
+	m_pFrameReady = 0;
+	m_pFrameDone = 0;
+	m_pMutex = 0;
+
+	// Hand the render context back to this thread for shutdown
+	SDL_GL_MakeCurrent(m_pWindow, m_renderContext);
+	GLStateCache::GetInstance().Invalidate();
+
+	RenderFrame& frame = m_frames[m_iRecordFrame];
+
+	if (frame.uploadFence != 0)
+	{
+		glDeleteSync(frame.uploadFence);
+		frame.uploadFence = 0;
+	}
+
+	DeleteTextures(frame.textureDeletes);
+	frame.queue.Clear();
+
+	SDL_GL_DeleteContext(m_loaderContext);
+	m_loaderContext = 0;
+}
+
+bool RenderThread::IsRunning() const
+{
+	return m_bRunning;
+}
+
+RenderFrame& RenderThread::GetRecordFrame()
+{
+	return m_frames[m_iRecordFrame];
+}
+
+void RenderThread::Submit(const ImDrawData* pImguiDrawData)
+{
+	RenderFrame& frame = m_frames[m_iRecordFrame];
+
+	CopyDrawData(frame.imguiDrawData, pImguiDrawData);
+
+	if (!m_bRunning)
+	{
+		m_pRenderer->ExecuteFrame(frame);
+		DeleteTextures(frame.textureDeletes);
+		return;
+	}
+
+	if (m_bTexturesUploaded)
+	{
+		// Uploads on the loader context aren't guaranteed visible to the render context until they complete
+		frame.uploadFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
+		m_bTexturesUploaded = false;
+	}
+
+	SDL_LockMutex(m_pMutex);
+
+	// Double buffered: wait for the previous frame to finish before handing over this one
+	while (m_pPendingFrame != 0)
+	{
+		SDL_CondWait(m_pFrameDone, m_pMutex);
+	}
+
+	m_pPendingFrame = &frame;
+	SDL_CondSignal(m_pFrameReady);
+
+	SDL_UnlockMutex(m_pMutex);
+
+	// The other frame was drawn before this one was accepted, so it is free to record into
+	m_iRecordFrame = 1 - m_iRecordFrame;
+}
+
+void RenderThread::OnTextureUploaded()
+{
+	m_bTexturesUploaded = true;
+}
+
+void RenderThread::DeleteTexture(unsigned int textureId)
+{
+	if (textureId == 0)
+	{
+		return;
+	}
+
+	if (m_bRunning)
+	{
+		// Frames already submitted may still draw with it
+		m_frames[m_iRecordFrame].textureDeletes.push_back(textureId);
+	}
+	else
+	{
+		GLStateCache::GetInstance().OnTextureDeleted(textureId);
+		glDeleteTextures(1, &textureId);
+	}
+}
+
+int RenderThread::RenderThreadMain(void* pData)
+{
+	RenderThread* pRenderThread = static_cast<RenderThread*>(pData);
+	pRenderThread->Run();
+
+	return 0;
+}
+
+void RenderThread::Run()
+{
+	SDL_GL_MakeCurrent(m_pWindow, m_renderContext);
+	GLStateCache::GetInstance().Invalidate();
+
+	while (true)
+	{
+		SDL_LockMutex(m_pMutex);
+
+		while (m_pPendingFrame == 0 && !m_bQuit)
+		{
+			SDL_CondWait(m_pFrameReady, m_pMutex);
+		}
+
+		RenderFrame* pFrame = m_pPendingFrame;
+
+		SDL_UnlockMutex(m_pMutex);
+
+		if (pFrame == 0)
+		{
+			break;
+		}
+
+		if (pFrame->uploadFence != 0)
+		{
+			glWaitSync(pFrame->uploadFence, 0, GL_TIMEOUT_IGNORED);
+			glDeleteSync(pFrame->uploadFence);
+			pFrame->uploadFence = 0;
+		}
+
+		m_pRenderer->ExecuteFrame(*pFrame);
+
+		DeleteTextures(pFrame->textureDeletes);
+
+		SDL_LockMutex(m_pMutex);
+		m_pPendingFrame = 0;
+		SDL_CondSignal(m_pFrameDone);
+		SDL_UnlockMutex(m_pMutex);
+	}
+
+	GLStateCache::DestroyInstance();
+	SDL_GL_MakeCurrent(m_pWindow, 0);
+}
+
+void RenderThread::DeleteTextures(std::vector<unsigned int>& textureIds)
+{
+	GLStateCache& stateCache = GLStateCache::GetInstance();
+
+	for (size_t k = 0; k < textureIds.size(); ++k)
+	{
+		stateCache.OnTextureDeleted(textureIds[k]);
+		glDeleteTextures(1, &textureIds[k]);
+	}
+
+	textureIds.clear();
+}
+
+void RenderThread::CopyDrawData(ImDrawData& destination, const ImDrawData* pSource)
+{
+	FreeDrawData(destination);
+
+	if (pSource == 0 || !pSource->Valid)
+	{
+		return;
+	}
+
+	destination.Valid = true;
+	destination.CmdListsCount = pSource->CmdListsCount;
+	destination.TotalIdxCount = pSource->TotalIdxCount;
+	destination.TotalVtxCount = pSource->TotalVtxCount;
+	destination.DisplayPos = pSource->DisplayPos;
+	destination.DisplaySize = pSource->DisplaySize;
+	destination.FramebufferScale = pSource->FramebufferScale;
+	destination.OwnerViewport = pSource->OwnerViewport;
+
+	for (int k = 0; k < pSource->CmdLists.Size; ++k)
+	{
+		destination.CmdLists.push_back(pSource->CmdLists[k]->CloneOutput());
+	}
+}
+
+void RenderThread::FreeDrawData(ImDrawData& drawData)
+{
+	for (int k = 0; k < drawData.CmdLists.Size; ++k)
+	{
+		IM_DELETE(drawData.CmdLists[k]);
+	}
+
+	drawData.Clear();
+}
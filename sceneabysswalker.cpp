@@ -769,6 +769,7 @@ void SceneAbyssWalker::CleanupDead()
 
 void SceneAbyssWalker::Draw(Renderer& renderer)
 {
+    renderer.SetLayer(RenderLayer::BACKGROUND);
     if (m_pmoonBackground) m_pmoonBackground->Draw(renderer);
 
     WaveState currentWaveState = WaveState::PRE_WAVE_DELAY;
@@ -782,15 +783,7 @@ void SceneAbyssWalker::Draw(Renderer& renderer)
         waveTimer = m_pWaveSystem->GetWaveTimer();
     }
 
-    if (currentWaveState == WaveState::INTERMISSION)
-    {
-        DrawUpgradeMenu(renderer);
-    }
-
-    if (currentWaveState == WaveState::GAME_WON || currentWaveState == WaveState::GAME_END_PROMPT)
-    {
-        DrawEndGamePrompts(renderer);
-    }
+    renderer.SetLayer(RenderLayer::WORLD);
 
     // Draws player
     if (m_pPlayer)
@@ -819,6 +812,8 @@ void SceneAbyssWalker::Draw(Renderer& renderer)
         }
     }
 
+    renderer.SetLayer(RenderLayer::HUD);
+
     // Player HUD
     if (m_pPlayerHUD)
     {
@@ -867,7 +862,7 @@ void SceneAbyssWalker::Draw(Renderer& renderer)
             float panelHeight = 30.0f;
             float panelX = (renderer.GetWidth() / 2.0f) - (panelWidth / 2.0f);
             float panelY = 20.0f;
-            renderer.DrawDebugRect(panelX, panelY, panelX + panelWidth, panelY + panelHeight, 30, 30, 30, 200);
+            renderer.DrawFilledRect(panelX, panelY, panelX + panelWidth, panelY + panelHeight, 30, 30, 30, 200);
             m_pWaveTimerTextSprite->SetX(static_cast<int>(panelX + panelWidth / 2.0f));
             m_pWaveTimerTextSprite->SetY(static_cast<int>(panelY + panelHeight / 2.0f));
             m_pWaveTimerTextSprite->Draw(renderer);
@@ -926,7 +921,7 @@ void SceneAbyssWalker::Draw(Renderer& renderer)
                 float panelX = groupStartX - panelWidth - m_pPlayerHUD->GetBarSpacing();
                 float panelY = barsY;
 
-                renderer.DrawDebugRect(panelX, panelY, panelX + panelWidth, panelY + panelHeight, 30, 30, 30, 200);
+                renderer.DrawFilledRect(panelX, panelY, panelX + panelWidth, panelY + panelHeight, 30, 30, 30, 200);
                 m_pWaveCountTextSprite->SetX(static_cast<int>(panelX + panelWidth / 2.0f));
                 m_pWaveCountTextSprite->SetY(static_cast<int>(panelY + panelHeight / 2.0f));
                 m_pWaveCountTextSprite->Draw(renderer);
@@ -953,14 +948,16 @@ void SceneAbyssWalker::Draw(Renderer& renderer)
         currentWaveState = m_pWaveSystem->GetCurrentState();
     }
 
+    renderer.SetLayer(RenderLayer::MENU);
+
     if (currentWaveState == WaveState::INTERMISSION)
     {
-        if (m_pUpgradeMenu) m_pUpgradeMenu->Draw(renderer);
+        DrawUpgradeMenu(renderer);
     }
 
     if (currentWaveState == WaveState::GAME_WON || currentWaveState == WaveState::GAME_END_PROMPT)
     {
-        if (m_pGameEndPrompt) m_pGameEndPrompt->Draw(renderer);
+        DrawEndGamePrompts(renderer);
     }
 }
 
@@ -6,17 +6,24 @@
 // Local includes:
 #include "logmanager.h"
 #include "matrix4.h"
+#include "glstatecache.h"
 
 // Library includes:
+#include <SDL.h>
 #include <cassert>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
+
+const char Shader::BINARY_CACHE_MAGIC[4] = { 'P', 'G', 'B', '1' };
 
 Shader::Shader()
 	: m_vertexShader(0)
 	, m_pixelShader(0)
 	, m_shaderProgram(0)
+	, m_sourceHash(0)
 {
 
 }
@@ -28,49 +35,180 @@ Shader::~Shader()
 
 bool Shader::Load(const char* vertexFile, const char* pixelFile)
 {
-	bool vertexCompiled = CompileShader(vertexFile, GL_VERTEX_SHADER, m_vertexShader);
-	bool pixelCompiled = CompileShader(pixelFile, GL_FRAGMENT_SHADER, m_pixelShader);
+	m_vertexFile = vertexFile;
+	m_pixelFile = pixelFile;
 
-	if (vertexCompiled == false || pixelCompiled == false)
+	std::string vertexSource;
+	std::string pixelSource;
+
+	if (!ReadSource(vertexFile, vertexSource) || !ReadSource(pixelFile, pixelSource))
 	{
-		LogManager::GetInstance().Log("Shaders failed to compile!");
 		assert(0);
 		return false;
 	}
 
-	m_shaderProgram = glCreateProgram();
+	m_sourceHash = HashString(pixelSource, HashString(vertexSource, HASH_SEED));
+
+	if (LoadProgramBinary(GetBinaryKey()))
+	{
+		return true;
+	}
 
-	glAttachShader(m_shaderProgram, m_vertexShader);
-	glAttachShader(m_shaderProgram, m_pixelShader);
-	glLinkProgram(m_shaderProgram);
+	GLuint program = 0;
+	GLuint vertexShader = 0;
+	GLuint pixelShader = 0;
+
+	if (!BuildProgram(vertexSource, pixelSource, program, vertexShader, pixelShader))
+	{
+		LogManager::GetInstance().Log("Shaders failed to compile!");
+		assert(0);
+		return false;
+	}
 
-	return IsValidProgram();
+	ReplaceProgram(program, vertexShader, pixelShader);
+	SaveProgramBinary(GetBinaryKey());
+
+	return true;
 }
 
 void Shader::Unload()
 {
+	m_uniformLocations.clear();
+
+	GLStateCache::GetInstance().OnProgramDeleted(m_shaderProgram);
 	glDeleteProgram(m_shaderProgram);
 	glDeleteShader(m_vertexShader);
 	glDeleteShader(m_pixelShader);
+
+	m_shaderProgram = 0;
+	m_vertexShader = 0;
+	m_pixelShader = 0;
+}
+
+bool Shader::ReloadIfChanged()
+{
+	std::string vertexSource;
+	std::string pixelSource;
+
+	if (!ReadSource(m_vertexFile.c_str(), vertexSource) || !ReadSource(m_pixelFile.c_str(), pixelSource))
+	{
+		// Possibly mid-save in an editor, looked at again on the next poll
+		return false;
+	}
+
+	unsigned long long sourceHash = HashString(pixelSource, HashString(vertexSource, HASH_SEED));
+
+	if (sourceHash == m_sourceHash)
+	{
+		return false;
+	}
+
+	// Remembered even if it fails, so a broken edit is reported once rather than every poll
+	m_sourceHash = sourceHash;
+
+	GLuint program = 0;
+	GLuint vertexShader = 0;
+	GLuint pixelShader = 0;
+
+	if (!BuildProgram(vertexSource, pixelSource, program, vertexShader, pixelShader))
+	{
+		LogManager::GetInstance().Log(("Shader reload failed, keeping the previous program: " + m_vertexFile + ", " + m_pixelFile).c_str());
+		return false;
+	}
+
+	ReplaceProgram(program, vertexShader, pixelShader);
+	SaveProgramBinary(GetBinaryKey());
+
+	LogManager::GetInstance().Log(("Shader reloaded: " + m_vertexFile + ", " + m_pixelFile).c_str());
+
+	return true;
+}
+
+void Shader::ReplaceProgram(GLuint program, GLuint vertexShader, GLuint pixelShader)
+{
+	Unload();
+
+	m_shaderProgram = program;
+	m_vertexShader = vertexShader;
+	m_pixelShader = pixelShader;
+
+	CacheUniformLocations();
 }
 
 void Shader::SetActive()
 {
 	assert(m_shaderProgram);
-	glUseProgram(m_shaderProgram);
+	GLStateCache::GetInstance().UseProgram(m_shaderProgram);
+}
+
+void Shader::CacheUniformLocations()
+{
+	m_uniformLocations.clear();
+
+	GLint numUniforms = 0;
+	glGetProgramiv(m_shaderProgram, GL_ACTIVE_UNIFORMS, &numUniforms);
+
+	char name[256];
+
+	for (GLint k = 0; k < numUniforms; ++k)
+	{
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		glGetActiveUniform(m_shaderProgram, k, sizeof(name), &length, &size, &type, name);
+
+		// Members of uniform blocks have no location and are set through their buffer instead
+		GLint location = glGetUniformLocation(m_shaderProgram, name);
+		if (location != -1)
+		{
+			m_uniformLocations[name] = location;
+		}
+	}
+}
+
+GLint Shader::GetUniformLocation(const char* name) const
+{
+	std::map<std::string, GLint>::const_iterator iter = m_uniformLocations.find(name);
+
+	if (iter == m_uniformLocations.end())
+	{
+		return -1;
+	}
+
+	return iter->second;
+}
+
+void Shader::BindUniformBlock(const char* blockName, GLuint bindingPoint)
+{
+	GLuint blockIndex = glGetUniformBlockIndex(m_shaderProgram, blockName);
+
+	if (blockIndex == GL_INVALID_INDEX)
+	{
+		LogManager::GetInstance().Log("Shader uniform block not found!");
+		return;
+	}
+
+	glUniformBlockBinding(m_shaderProgram, blockIndex, bindingPoint);
 }
 
 void Shader::SetMatrixUniform(const char* name, const Matrix4& matrix)
 {
-	GLuint location = glGetUniformLocation(m_shaderProgram, name);
+	SetMatrixUniform(GetUniformLocation(name), matrix);
+}
 
+void Shader::SetMatrixUniform(GLint location, const Matrix4& matrix)
+{
 	glUniformMatrix4fv(location, 1, GL_TRUE, (float*)&matrix);
+	++GLStateCache::GetInstance().GetStats().uniformUploads;
 }
 
 void Shader::SetVector4Uniform(const char* name, float x, float y, float z, float w)
 {
-	GLuint location = glGetUniformLocation(m_shaderProgram, name);
+	SetVector4Uniform(GetUniformLocation(name), x, y, z, w);
+}
 
+void Shader::SetVector4Uniform(GLint location, float x, float y, float z, float w)
+{
 	float vec4[4];
 
 	vec4[0] = x;
@@ -79,35 +217,240 @@ void Shader::SetVector4Uniform(const char* name, float x, float y, float z, floa
 	vec4[3] = w;
 
 	glUniform4fv(location, 1, vec4);
+	++GLStateCache::GetInstance().GetStats().uniformUploads;
 }
 
-bool Shader::CompileShader(const char* filename, GLenum shaderType, GLuint& outShader)
+void Shader::SetIntegerUniform(const char* name, int value)
 {
-	std::ifstream shaderFile(filename);
+	SetIntegerUniform(GetUniformLocation(name), value);
+}
+
+void Shader::SetIntegerUniform(GLint location, int value)
+{
+	glUniform1i(location, value);
+	++GLStateCache::GetInstance().GetStats().uniformUploads;
+}
+
+bool Shader::LoadProgramBinary(unsigned long long key)
+{
+	if (!IsProgramBinarySupported())
+	{
+		return false;
+	}
+
+	std::ifstream file(GetBinaryCacheFile().c_str(), std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	// Native byte order, the cache never leaves the machine that wrote it
+	char magic[4];
+	unsigned long long fileKey = 0;
+	GLenum format = 0;
+	GLint length = 0;
+
+	file.read(magic, 4);
+	file.read(reinterpret_cast<char*>(&fileKey), sizeof(fileKey));
+	file.read(reinterpret_cast<char*>(&format), sizeof(format));
+	file.read(reinterpret_cast<char*>(&length), sizeof(length));
+
+	if (!file.good() || memcmp(magic, BINARY_CACHE_MAGIC, 4) != 0 || fileKey != key || length <= 0)
+	{
+		return false;
+	}
+
+	std::vector<char> binary(length);
+	file.read(&binary[0], length);
+
+	if (!file.good())
+	{
+		return false;
+	}
+
+	GLuint program = glCreateProgram();
+	glProgramBinary(program, format, &binary[0], length);
 
-	if (shaderFile.is_open())
+	GLint linkedStatus = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &linkedStatus);
+
+	if (linkedStatus != GL_TRUE)
+	{
+		// The driver may reject its own binaries after an update, the sources are still there
+		glDeleteProgram(program);
+		return false;
+	}
+
+	ReplaceProgram(program, 0, 0);
+
+	return true;
+}
+
+void Shader::SaveProgramBinary(unsigned long long key) const
+{
+	if (!IsProgramBinarySupported())
+	{
+		return;
+	}
+
+	GLint length = 0;
+	glGetProgramiv(m_shaderProgram, GL_PROGRAM_BINARY_LENGTH, &length);
+
+	if (length <= 0)
+	{
+		return;
+	}
+
+	std::vector<char> binary(length);
+	GLenum format = 0;
+	glGetProgramBinary(m_shaderProgram, length, &length, &format, &binary[0]);
+
+	// Optional, e.g. a read only install just compiles every start
+	std::ofstream file(GetBinaryCacheFile().c_str(), std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		return;
+	}
+
+	file.write(BINARY_CACHE_MAGIC, 4);
+	file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+	file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+	file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+	file.write(&binary[0], length);
+}
+
+std::string Shader::GetBinaryCacheFile() const
+{
+	const std::string& directory = GetBinaryCacheDirectory();
+
+	if (directory.empty())
 	{
-		std::stringstream sstream;
-		sstream << shaderFile.rdbuf();
-		std::string shaderCode = sstream.str();
-		const char* pShaderCode = shaderCode.c_str();
+		return std::string();
+	}
 
-		outShader = glCreateShader(shaderType);
-		glShaderSource(outShader, 1, &(pShaderCode), 0);
-		glCompileShader(outShader);
+	// Named after both stages, e.g. sprite.vert.spritearray.frag.bin
+	return directory + GetFileName(m_vertexFile) + "." + GetFileName(m_pixelFile) + ".bin";
+}
 
-		if (!IsCompiled(outShader))
+const std::string& Shader::GetBinaryCacheDirectory()
+{
+	// Per user and out of the source tree: a binary only suits the driver on the machine that wrote it.
+	// Empty when there is none, then nothing is cached and every start compiles.
+	static std::string directory;
+	static bool bLookedUp = false;
+
+	if (!bLookedUp)
+	{
+		char* pPrefPath = SDL_GetPrefPath("COMP710", "DemoGame2025");
+
+		if (pPrefPath)
 		{
-			LogManager::GetInstance().Log("Shader failed to compile!");
-			return false;
+			directory = pPrefPath;
+			SDL_free(pPrefPath);
 		}
-	} 
-	else
+
+		bLookedUp = true;
+	}
+
+	return directory;
+}
+
+std::string Shader::GetFileName(const std::string& path)
+{
+	size_t slash = path.find_last_of("/\\");
+	return (slash == std::string::npos) ? path : path.substr(slash + 1);
+}
+
+unsigned long long Shader::GetBinaryKey() const
+{
+	// A binary only means something to the driver that wrote it
+	unsigned long long key = m_sourceHash;
+	const GLenum driverStrings[3] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+
+	for (int k = 0; k < 3; ++k)
+	{
+		const GLubyte* pDriverString = glGetString(driverStrings[k]);
+
+		if (pDriverString)
+		{
+			key = HashString(reinterpret_cast<const char*>(pDriverString), key);
+		}
+	}
+
+	return key;
+}
+
+bool Shader::ReadSource(const char* filename, std::string& source)
+{
+	std::ifstream shaderFile(filename);
+
+	if (!shaderFile.is_open())
 	{
 		LogManager::GetInstance().Log("Shader file not found!");
 		return false;
 	}
 
+	std::stringstream sstream;
+	sstream << shaderFile.rdbuf();
+	source = sstream.str();
+
+	return true;
+}
+
+bool Shader::BuildProgram(const std::string& vertexSource, const std::string& pixelSource, GLuint& outProgram, GLuint& outVertexShader, GLuint& outPixelShader)
+{
+	bool vertexCompiled = CompileShader(vertexSource, GL_VERTEX_SHADER, outVertexShader);
+	bool pixelCompiled = CompileShader(pixelSource, GL_FRAGMENT_SHADER, outPixelShader);
+
+	if (vertexCompiled == false || pixelCompiled == false)
+	{
+		glDeleteShader(outVertexShader);
+		glDeleteShader(outPixelShader);
+		outVertexShader = 0;
+		outPixelShader = 0;
+		return false;
+	}
+
+	outProgram = glCreateProgram();
+
+	if (IsProgramBinarySupported())
+	{
+		glProgramParameteri(outProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
+	glAttachShader(outProgram, outVertexShader);
+	glAttachShader(outProgram, outPixelShader);
+	glLinkProgram(outProgram);
+
+	if (!IsLinked(outProgram))
+	{
+		glDeleteProgram(outProgram);
+		glDeleteShader(outVertexShader);
+		glDeleteShader(outPixelShader);
+		outProgram = 0;
+		outVertexShader = 0;
+		outPixelShader = 0;
+		return false;
+	}
+
+	return true;
+}
+
+bool Shader::CompileShader(const std::string& source, GLenum shaderType, GLuint& outShader)
+{
+	const char* pShaderCode = source.c_str();
+
+	outShader = glCreateShader(shaderType);
+	glShaderSource(outShader, 1, &(pShaderCode), 0);
+	glCompileShader(outShader);
+
+	if (!IsCompiled(outShader))
+	{
+		return false;
+	}
+
 	return true;
 }
 
@@ -124,6 +467,7 @@ bool Shader::IsCompiled(GLuint shader)
 		glGetShaderInfoLog(shader, 1023, 0, error);
 
 		LogManager::GetInstance().Log("Shader failed to compile!");
+		LogManager::GetInstance().Log(error);
 
 		return false;
 	}
@@ -131,23 +475,48 @@ bool Shader::IsCompiled(GLuint shader)
 	return true;
 }
 
-bool Shader::IsValidProgram()
+bool Shader::IsLinked(GLuint program)
 {
 	GLint linkedStatus;
 
-	glGetProgramiv(m_shaderProgram, GL_LINK_STATUS, &linkedStatus);
+	glGetProgramiv(program, GL_LINK_STATUS, &linkedStatus);
 
 	if (linkedStatus != GL_TRUE)
 	{
 		char error[1024];
 		error[0] = 0;
-		glGetShaderInfoLog(m_shaderProgram, 1023, 0, error);
+		glGetProgramInfoLog(program, 1023, 0, error);
 
 		LogManager::GetInstance().Log("Shader failed to link!");
-		assert(0);
+		LogManager::GetInstance().Log(error);
 
 		return false;
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+unsigned long long Shader::HashString(const std::string& text, unsigned long long hash)
+{
+	for (size_t k = 0; k < text.size(); ++k)
+	{
+		hash ^= static_cast<unsigned char>(text[k]);
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+bool Shader::IsProgramBinarySupported()
+{
+	if (!GLEW_ARB_get_program_binary)
+	{
+		return false;
+	}
+
+	// Some drivers expose the entry points but no format to save in
+	GLint numFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+
+	return numFormats > 0;
+}
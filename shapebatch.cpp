@@ -0,0 +1,169 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "shapebatch.h"
+
+// Local includes:
+#include "glstatecache.h"
+#include "vertexarray.h"
+
+// Library includes:
+#include <glew.h>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+ShapeBatch::ShapeBatch()
+	: m_verticesPerUpload(0)
+	, m_pVertexStream(0)
+	, m_glVertexArray(0)
+	, m_iLastFlushDrawCalls(0)
+{
+
+}
+
+ShapeBatch::~ShapeBatch()
+{
+	delete m_pVertexStream;
+	m_pVertexStream = 0;
+	GLStateCache::GetInstance().OnVertexArrayDeleted(m_glVertexArray);
+	glDeleteVertexArrays(1, &m_glVertexArray);
+}
+
+bool ShapeBatch::Initialise(unsigned int verticesPerUpload)
+{
+	// Whole triangles only, so a split flush never cuts one in half
+	m_verticesPerUpload = (verticesPerUpload / 3) * 3;
+	assert(m_verticesPerUpload > 0);
+	m_vertices.reserve(m_verticesPerUpload);
+
+	const int stride = sizeof(ShapeVertex); // XYRGBA
+
+	glGenVertexArrays(1, &m_glVertexArray);
+	GLStateCache::GetInstance().BindVertexArray(m_glVertexArray);
+
+	// Plus a stride of slack for aligning each upload
+	m_pVertexStream = new StreamingBuffer();
+	m_pVertexStream->Initialise((m_verticesPerUpload + 1) * stride);
+
+	static const VertexAttribute attributes[] =
+	{
+		{ 0, 2, GL_FLOAT, GL_FALSE, offsetof(ShapeVertex, x) }, // XY
+		{ 1, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(ShapeVertex, r) } // RGBA
+	};
+
+	// Draws address the stream by first vertex, so the attributes always start at zero
+	VertexFormat format = { attributes, 2, stride, 0 };
+	EnableVertexFormat(format);
+	PointVertexFormat(format, 0);
+
+	GLStateCache::GetInstance().BindVertexArray(0);
+
+	return true;
+}
+
+void ShapeBatch::AddQuad(const float cornersX[4], const float cornersY[4], unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+	// Two triangles: 0,1,2 and 2,3,0
+	const int order[6] = { 0, 1, 2, 2, 3, 0 };
+
+	for (int k = 0; k < 6; ++k)
+	{
+		ShapeVertex vertex;
+		vertex.x = cornersX[order[k]];
+		vertex.y = cornersY[order[k]];
+		vertex.r = r;
+		vertex.g = g;
+		vertex.b = b;
+		vertex.a = a;
+
+		m_vertices.push_back(vertex);
+	}
+}
+
+void ShapeBatch::AddFilledRect(float x1, float y1, float x2, float y2, unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+	const float cornersX[4] = { x1, x2, x2, x1 };
+	const float cornersY[4] = { y1, y1, y2, y2 };
+
+	AddQuad(cornersX, cornersY, r, g, b, a);
+}
+
+void ShapeBatch::AddOutlinedRect(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+	// Border sits inside the rect, the sides are trimmed so the corners aren't blended twice
+	AddFilledRect(x1, y1, x2, y1 + thickness, r, g, b, a); // Top
+	AddFilledRect(x1, y2 - thickness, x2, y2, r, g, b, a); // Bottom
+	AddFilledRect(x1, y1 + thickness, x1 + thickness, y2 - thickness, r, g, b, a); // Left
+	AddFilledRect(x2 - thickness, y1 + thickness, x2, y2 - thickness, r, g, b, a); // Right
+}
+
+void ShapeBatch::AddLine(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+	float dx = x2 - x1;
+	float dy = y2 - y1;
+	float length = sqrtf((dx * dx) + (dy * dy));
+
+	if (length <= 0.0f)
+	{
+		return;
+	}
+
+	// Offset both ends by half the thickness along the line's normal
+	float normalX = (-dy / length) * (thickness / 2.0f);
+	float normalY = (dx / length) * (thickness / 2.0f);
+
+	const float cornersX[4] = { x1 + normalX, x2 + normalX, x2 - normalX, x1 - normalX };
+	const float cornersY[4] = { y1 + normalY, y2 + normalY, y2 - normalY, y1 - normalY };
+
+	AddQuad(cornersX, cornersY, r, g, b, a);
+}
+
+void ShapeBatch::Flush()
+{
+	m_iLastFlushDrawCalls = 0;
+
+	if (m_vertices.empty())
+	{
+		return;
+	}
+
+	GLStateCache& stateCache = GLStateCache::GetInstance();
+	RenderStats& stats = stateCache.GetStats();
+
+	stateCache.BindVertexArray(m_glVertexArray);
+
+	const unsigned int stride = sizeof(ShapeVertex);
+	const unsigned int numVertices = static_cast<unsigned int>(m_vertices.size());
+
+	// Usually one upload and one draw, a busy frame is split rather than growing the stream
+	for (unsigned int first = 0; first < numVertices; first += m_verticesPerUpload)
+	{
+		unsigned int count = numVertices - first;
+
+		if (count > m_verticesPerUpload)
+		{
+			count = m_verticesPerUpload;
+		}
+
+		unsigned int offset = m_pVertexStream->Upload(&m_vertices[first], count * stride, stride);
+
+		glDrawArrays(GL_TRIANGLES, static_cast<GLint>(offset / stride), static_cast<GLsizei>(count));
+
+		++m_iLastFlushDrawCalls;
+		++stats.drawCalls;
+		stats.triangles += count / 3;
+	}
+
+	m_vertices.clear();
+}
+
+bool ShapeBatch::IsEmpty() const
+{
+	return m_vertices.empty();
+}
+
+int ShapeBatch::GetLastFlushDrawCalls() const
+{
+	return m_iLastFlushDrawCalls;
+}
@@ -17,6 +17,7 @@ Sprite::Sprite()
 	, m_width(0)
 	, m_height(0)
 	, m_angle(0.0f)
+	, m_bRotationDirty(true)
 	, m_centerX(0)
 	, m_centerY(0)
 	, m_scaleX(1.0f)
@@ -26,6 +27,7 @@ Sprite::Sprite()
 	, m_tintGreen(1.0f)
 	, m_tintBlue(1.0f)
 	, m_bFlipHorizontal(false)
+	, m_uiPaletteRow(0)
 {
 }
 
@@ -36,6 +38,7 @@ Sprite::~Sprite()
 bool Sprite::Initialise(Texture& texture)
 {
 	m_pTexture = &texture;
+	m_uiPaletteRow = m_pTexture->GetPaletteRow();
 
 	m_width = m_pTexture->GetWidth();
 	m_height = m_pTexture->GetHeight();
@@ -81,7 +84,6 @@ void Sprite::Draw(Renderer& renderer)
 {
 	if (m_pTexture && m_pTexture->GetWidth() > 0 && m_pTexture->GetHeight() > 0)
 	{
-		m_pTexture->SetActive();
 		renderer.DrawSprite(*this, m_bFlipHorizontal);
 	}
 }
@@ -114,7 +116,11 @@ void Sprite::SetAngle(float angle)
 		angle -= 360.0f;
 	}
 
-	m_angle = angle;
+	if (angle != m_angle)
+	{
+		m_angle = angle;
+		m_bRotationDirty = true;
+	}
 }
 
 float Sprite::GetAngle() const
@@ -122,6 +128,44 @@ float Sprite::GetAngle() const
 	return m_angle;
 }
 
+const SpriteRotation& Sprite::GetRotation() const
+{
+	if (m_bRotationDirty)
+	{
+		UpdateRotation();
+	}
+
+	return m_rotation;
+}
+
+void Sprite::UpdateRotation() const
+{
+	const float PI = 3.14159f;
+	m_rotation.radians = (m_angle * PI) / 180.0f;
+
+	// SetAngle leaves 0 as 360, and 180 is how most of our sprites are turned the right way up
+	if (m_angle == 0.0f || m_angle == 360.0f)
+	{
+		m_rotation.cosine = 1.0f;
+		m_rotation.sine = 0.0f;
+		m_rotation.bRotated = false;
+	}
+	else if (m_angle == 180.0f)
+	{
+		m_rotation.cosine = -1.0f;
+		m_rotation.sine = 0.0f;
+		m_rotation.bRotated = false;
+	}
+	else
+	{
+		m_rotation.cosine = cosf(m_rotation.radians);
+		m_rotation.sine = sinf(m_rotation.radians);
+		m_rotation.bRotated = true;
+	}
+
+	m_bRotationDirty = false;
+}
+
 void Sprite::SetScale(float scaleX, float scaleY)
 {
 	m_scaleX = scaleX;
@@ -210,4 +254,14 @@ void Sprite::SetBlueTint(float value)
 float Sprite::GetBlueTint() const
 {
 	return m_tintBlue;
-}
\ No newline at end of file
+}
+
+void Sprite::SetPaletteRow(unsigned int paletteRow)
+{
+	m_uiPaletteRow = paletteRow;
+}
+
+unsigned int Sprite::GetPaletteRow() const
+{
+	return m_uiPaletteRow;
+}
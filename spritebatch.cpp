@@ -0,0 +1,245 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "spritebatch.h"
+
+// Local includes:
+#include "glstatecache.h"
+#include "vertexarray.h"
+
+// Library includes:
+#include <glew.h>
+#include <cassert>
+#include <cstddef>
+#include <cmath>
+
+SpriteBatch::SpriteBatch()
+	: m_maxInstances(0)
+	, m_bTextureArrays(false)
+	, m_iLastFlushDrawCalls(0)
+	, m_glQuadBuffer(0)
+	, m_glIndexBuffer(0)
+	, m_pInstanceStream(0)
+	, m_glVertexArray(0)
+{
+
+}
+
+SpriteBatch::~SpriteBatch()
+{
+	glDeleteBuffers(1, &m_glQuadBuffer);
+	glDeleteBuffers(1, &m_glIndexBuffer);
+	delete m_pInstanceStream;
+	m_pInstanceStream = 0;
+	GLStateCache::GetInstance().OnVertexArrayDeleted(m_glVertexArray);
+	glDeleteVertexArrays(1, &m_glVertexArray);
+}
+
+bool SpriteBatch::Initialise(unsigned int maxInstances, bool bTextureArrays)
+{
+	assert(maxInstances > 0);
+	m_maxInstances = maxInstances;
+	m_bTextureArrays = bTextureArrays;
+
+	m_instances.reserve(m_maxInstances);
+	m_runs.reserve(64);
+
+	// Corner of the unit quad in UV space, (0, 0) is top left: TL, TR, BR, BL
+	float corners[] =
+	{
+		0.0f, 0.0f,
+		1.0f, 0.0f,
+		1.0f, 1.0f,
+		0.0f, 1.0f
+	};
+
+	unsigned int indices[] = { 0,1,2,2,3,0 };
+
+	glGenVertexArrays(1, &m_glVertexArray);
+	GLStateCache::GetInstance().BindVertexArray(m_glVertexArray);
+
+	glGenBuffers(1, &m_glQuadBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, m_glQuadBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+
+	static const VertexAttribute cornerAttributes[] =
+	{
+		{ 0, 2, GL_FLOAT, GL_FALSE, 0 } // Corner
+	};
+
+	VertexFormat cornerFormat = { cornerAttributes, 1, 2 * sizeof(float), 0 };
+	EnableVertexFormat(cornerFormat);
+	PointVertexFormat(cornerFormat, 0);
+
+	glGenBuffers(1, &m_glIndexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_glIndexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+	// A full batch per upload, plus a stride of slack for aligning it
+	m_pInstanceStream = new StreamingBuffer();
+	m_pInstanceStream->Initialise((m_maxInstances + 1) * sizeof(PackedSpriteInstance));
+
+	EnableVertexFormat(GetInstanceFormat());
+	SetInstanceAttributes(0);
+
+	GLStateCache::GetInstance().BindVertexArray(0);
+
+	return true;
+}
+
+void SpriteBatch::SetInstanceAttributes(unsigned int byteOffset)
+{
+	// GL 3.3 has no base instance for instanced draws, so each run re-points the instance stream instead
+	PointVertexFormat(GetInstanceFormat(), byteOffset);
+}
+
+const VertexFormat& SpriteBatch::GetInstanceFormat()
+{
+	static const VertexAttribute attributes[] =
+	{
+		{ 1, 2, GL_FLOAT, GL_FALSE, offsetof(PackedSpriteInstance, x) }, // Position
+		{ 2, 4, GL_HALF_FLOAT, GL_FALSE, offsetof(PackedSpriteInstance, sizeX) }, // Size, angle, flip
+		{ 3, 4, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(PackedSpriteInstance, uvs) }, // UV rect
+		{ 4, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(PackedSpriteInstance, r) }, // Tint
+		{ 5, 1, GL_UNSIGNED_SHORT, GL_FALSE, offsetof(PackedSpriteInstance, layer) }, // Texture array layer
+		{ 6, 1, GL_UNSIGNED_SHORT, GL_FALSE, offsetof(PackedSpriteInstance, palette) } // Palette row
+	};
+
+	static const VertexFormat format = { attributes, 6, sizeof(PackedSpriteInstance), 1 };
+
+	return format;
+}
+
+void SpriteBatch::PackInstance(PackedSpriteInstance& packed, const SpriteInstance& instance)
+{
+	const float PI = 3.14159265f;
+	const float TWO_PI = 2.0f * PI;
+
+	// Keep the angle small, half floats lose precision quickly as it grows
+	float angle = fmodf(instance.angle, TWO_PI);
+
+	if (angle > PI)
+	{
+		angle -= TWO_PI;
+	}
+	else if (angle < -PI)
+	{
+		angle += TWO_PI;
+	}
+
+	packed.x = instance.x;
+	packed.y = instance.y;
+	packed.sizeX = FloatToHalf(instance.sizeX);
+	packed.sizeY = FloatToHalf(instance.sizeY);
+	packed.angle = FloatToHalf(angle);
+	packed.flip = FloatToHalf(instance.flip);
+
+	packed.uvs[0] = PackUnorm16(instance.uvs.u0);
+	packed.uvs[1] = PackUnorm16(instance.uvs.v0);
+	packed.uvs[2] = PackUnorm16(instance.uvs.u1);
+	packed.uvs[3] = PackUnorm16(instance.uvs.v1);
+
+	packed.r = PackUnorm8(instance.r);
+	packed.g = PackUnorm8(instance.g);
+	packed.b = PackUnorm8(instance.b);
+	packed.a = PackUnorm8(instance.a);
+
+	assert(instance.layer <= 0xFFFF);
+	packed.layer = static_cast<unsigned short>(instance.layer);
+
+	assert(instance.palette <= 0xFFFF);
+	packed.palette = static_cast<unsigned short>(instance.palette);
+}
+
+unsigned short SpriteBatch::PackUnorm16(float value)
+{
+	value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+
+	return static_cast<unsigned short>(value * 65535.0f + 0.5f);
+}
+
+unsigned char SpriteBatch::PackUnorm8(float value)
+{
+	value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+
+	return static_cast<unsigned char>(value * 255.0f + 0.5f);
+}
+
+void SpriteBatch::AddSprite(unsigned int textureId, const SpriteInstance& instance)
+{
+	assert(!IsFull());
+
+	unsigned int instanceIndex = static_cast<unsigned int>(m_instances.size());
+
+	if (m_runs.empty() || m_runs.back().textureId != textureId)
+	{
+		TextureRun run;
+		run.textureId = textureId;
+		run.firstInstance = instanceIndex;
+		run.numInstances = 0;
+		m_runs.push_back(run);
+	}
+
+	++m_runs.back().numInstances;
+
+	m_instances.push_back(PackedSpriteInstance());
+	PackInstance(m_instances.back(), instance);
+}
+
+void SpriteBatch::Flush()
+{
+	m_iLastFlushDrawCalls = 0;
+
+	if (m_instances.empty())
+	{
+		return;
+	}
+
+	GLStateCache& stateCache = GLStateCache::GetInstance();
+	RenderStats& stats = stateCache.GetStats();
+
+	stateCache.BindVertexArray(m_glVertexArray);
+
+	const unsigned int stride = sizeof(PackedSpriteInstance);
+	const unsigned int uploadSize = static_cast<unsigned int>(m_instances.size()) * stride;
+	const unsigned int uploadOffset = m_pInstanceStream->Upload(&m_instances[0], uploadSize, stride);
+
+	for (size_t k = 0; k < m_runs.size(); ++k)
+	{
+		const TextureRun& run = m_runs[k];
+
+		SetInstanceAttributes(uploadOffset + run.firstInstance * stride);
+
+		if (m_bTextureArrays)
+		{
+			stateCache.BindTextureArray(0, run.textureId);
+		}
+		else
+		{
+			stateCache.BindTexture(0, run.textureId);
+		}
+		glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, run.numInstances);
+
+		++m_iLastFlushDrawCalls;
+		++stats.drawCalls;
+		stats.triangles += 2 * run.numInstances;
+	}
+
+	m_instances.clear();
+	m_runs.clear();
+}
+
+bool SpriteBatch::IsEmpty() const
+{
+	return m_instances.empty();
+}
+
+bool SpriteBatch::IsFull() const
+{
+	return m_instances.size() >= m_maxInstances;
+}
+
+int SpriteBatch::GetLastFlushDrawCalls() const
+{
+	return m_iLastFlushDrawCalls;
+}
@@ -5,41 +5,71 @@
 
 // Local includes:
 #include "logmanager.h"
+#include "glstatecache.h"
+#include "renderthread.h"
+#include "paletteatlas.h"
 
 // Library include:
 #include <SDL_image.h>
 #include <cassert>
+#include <cstring>
 #include <glew.h>
 #include <SDL_ttf.h>
+#include <fstream>
 
+// Static Members:
+bool Texture::sm_bHeadless = false;
 
 Texture::Texture()
 	: m_uiTextureId(0)
 	, m_iHeight(0)
 	, m_iWidth(0)
+	, m_bOwnsTexture(true)
+	, m_bStorageReleased(false)
+	, m_iRegionX(0)
+	, m_iRegionY(0)
+	, m_iPageWidth(0)
+	, m_iPageHeight(0)
+	, m_uiPaletteRow(PaletteAtlas::NO_PALETTE)
 {
 }
 
 Texture::~Texture()
 {
-	if (m_uiTextureId != 0)
+	// Deferred while the render thread may still be drawing with it
+	if (m_bOwnsTexture)
 	{
-		glDeleteTextures(1, &m_uiTextureId);
-		m_uiTextureId = 0;
+		RenderThread::GetInstance().DeleteTexture(m_uiTextureId);
 	}
+	m_uiTextureId = 0;
 }
 
-bool Texture::Initialise(const char* pcFilename)
+bool Texture::Initialise(const char* pcFilename, bool bAllowIndexed)
 {
+	m_filename = pcFilename;
+
+	if (sm_bHeadless)
+	{
+		if (!ReadImageSize(pcFilename, m_iWidth, m_iHeight))
+		{
+			LogManager::GetInstance().Log("Texture failed to load!");
+			return false;
+		}
+
+		return true;
+	}
+
 	SDL_Surface* pSurface = IMG_Load(pcFilename);
 
-	if (pSurface)
+	if (pSurface && bAllowIndexed && InitialiseIndexed(pSurface))
 	{
-		GLint previousUnpackAlignment;
-		glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousUnpackAlignment);
-		GLint previousUnpackRowLength;
-		glGetIntegerv(GL_UNPACK_ROW_LENGTH, &previousUnpackRowLength);
+		SDL_FreeSurface(pSurface);
+		RenderThread::GetInstance().OnTextureUploaded();
+		return true;
+	}
 
+	if (pSurface)
+	{
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
 		glPixelStorei(GL_UNPACK_ROW_LENGTH, pSurface->pitch / pSurface->format->BytesPerPixel);
@@ -87,24 +117,25 @@ bool Texture::Initialise(const char* pcFilename)
 		else
 		{
 			SDL_FreeSurface(pSurface);
-			glPixelStorei(GL_UNPACK_ALIGNMENT, previousUnpackAlignment);
-			glPixelStorei(GL_UNPACK_ROW_LENGTH, previousUnpackRowLength);
+			RestoreDefaultUnpackState();
 			return false;
 		}
 
 		glGenTextures(1, &m_uiTextureId);
-		glBindTexture(GL_TEXTURE_2D, m_uiTextureId);
+		GLStateCache::GetInstance().BindTexture(0, m_uiTextureId);
 
 		glTexImage2D(GL_TEXTURE_2D, 0, internalGlFormat, m_iWidth, m_iHeight, 0, surfacePixelGlFormat, GL_UNSIGNED_BYTE, pSurface->pixels);
+		GLStateCache::GetInstance().GetStats().AddTextureUpload(m_iWidth * m_iHeight * pSurface->format->BytesPerPixel);
 
 		SDL_FreeSurface(pSurface);
 		pSurface = nullptr;
 
-		glPixelStorei(GL_UNPACK_ALIGNMENT, previousUnpackAlignment);
-		glPixelStorei(GL_UNPACK_ROW_LENGTH, previousUnpackRowLength);
+		RestoreDefaultUnpackState();
 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST); // NOTE: Must be GL_NEAREST otherwise the pixels will mess up
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+		RenderThread::GetInstance().OnTextureUploaded();
 	}
 	else
 	{
@@ -116,9 +147,111 @@ bool Texture::Initialise(const char* pcFilename)
 	return true;
 }
 
+bool Texture::InitialiseRegion(const Texture& page, int x, int y, int width, int height)
+{
+	if (page.m_iWidth == 0 || x < 0 || y < 0 || x + width > page.m_iWidth || y + height > page.m_iHeight)
+	{
+		LogManager::GetInstance().Log("Atlas region is outside its page!");
+		return false;
+	}
+
+	m_uiTextureId = page.m_uiTextureId;
+	m_bOwnsTexture = false;
+
+	m_iWidth = width;
+	m_iHeight = height;
+	m_iRegionX = x;
+	m_iRegionY = y;
+	m_iPageWidth = page.m_iWidth;
+	m_iPageHeight = page.m_iHeight;
+
+	// An indexed page's palette covers every region on it
+	m_palette = page.m_palette;
+	m_uiPaletteRow = page.m_uiPaletteRow;
+
+	return true;
+}
+
+bool Texture::InitialiseIndexed(SDL_Surface* pSurface)
+{
+	SDL_Surface* pRgbaSurface = SDL_ConvertSurfaceFormat(pSurface, SDL_PIXELFORMAT_RGBA32, 0);
+
+	if (pRgbaSurface == 0)
+	{
+		return false;
+	}
+
+	std::vector<unsigned char> indices;
+	bool indexed = PaletteAtlas::IndexPixels(static_cast<const unsigned char*>(pRgbaSurface->pixels)
+		, pRgbaSurface->w, pRgbaSurface->h, pRgbaSurface->pitch, m_palette, indices);
+
+	if (indexed)
+	{
+		m_iWidth = pRgbaSurface->w;
+		m_iHeight = pRgbaSurface->h;
+
+		glGenTextures(1, &m_uiTextureId);
+		GLStateCache::GetInstance().BindTexture(0, m_uiTextureId);
+
+		// A quarter of the RGBA upload, the colours come from the palette in the sprite shaders
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, m_iWidth, m_iHeight, 0, GL_RED, GL_UNSIGNED_BYTE, indices.data());
+		GLStateCache::GetInstance().GetStats().AddTextureUpload(m_iWidth * m_iHeight);
+		RestoreDefaultUnpackState();
+
+		// NOTE: Indices can't be filtered, GL_NEAREST is required here
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	}
+	else
+	{
+		m_palette.clear();
+	}
+
+	SDL_FreeSurface(pRgbaSurface);
+
+	return indexed;
+}
+
+void Texture::ReleaseStorage()
+{
+	// Headless textures have nothing to release, an atlas region's storage is its page's
+	if (sm_bHeadless || !m_bOwnsTexture || m_filename.empty() || m_bStorageReleased)
+	{
+		return;
+	}
+
+	// Deferred while the render thread may still be drawing with it
+	RenderThread::GetInstance().DeleteTexture(m_uiTextureId);
+	m_uiTextureId = 0;
+	m_bStorageReleased = true;
+}
+
+bool Texture::RestoreStorage()
+{
+	if (!m_bStorageReleased)
+	{
+		return true;
+	}
+
+	// The same pixels index to the same palette, so the row it was given still fits
+	unsigned int paletteRow = m_uiPaletteRow;
+	bool restored = Initialise(m_filename.c_str(), IsIndexed());
+	m_uiPaletteRow = paletteRow;
+
+	m_bStorageReleased = !restored;
+
+	return restored;
+}
+
+bool Texture::IsStorageReleased() const
+{
+	return m_bStorageReleased;
+}
+
 void Texture::SetActive()
 {
-	glBindTexture(GL_TEXTURE_2D, m_uiTextureId);
+	GLStateCache::GetInstance().BindTexture(0, m_uiTextureId);
 }
 
 int Texture::GetWidth() const
@@ -131,6 +264,64 @@ int Texture::GetHeight() const
 	return (m_iHeight);
 }
 
+unsigned int Texture::GetTextureId() const
+{
+	return (m_uiTextureId);
+}
+
+bool Texture::IsRegion() const
+{
+	return !m_bOwnsTexture;
+}
+
+float Texture::MapU(float u) const
+{
+	if (m_bOwnsTexture)
+	{
+		return u;
+	}
+
+	return (m_iRegionX + (u * m_iWidth)) / m_iPageWidth;
+}
+
+float Texture::MapV(float v) const
+{
+	if (m_bOwnsTexture)
+	{
+		return v;
+	}
+
+	return (m_iRegionY + (v * m_iHeight)) / m_iPageHeight;
+}
+
+void Texture::GetRegion(int& x, int& y, int& pageWidth, int& pageHeight) const
+{
+	x = m_iRegionX;
+	y = m_iRegionY;
+	pageWidth = m_bOwnsTexture ? m_iWidth : m_iPageWidth;
+	pageHeight = m_bOwnsTexture ? m_iHeight : m_iPageHeight;
+}
+
+bool Texture::IsIndexed() const
+{
+	return !m_palette.empty();
+}
+
+const std::vector<unsigned int>& Texture::GetPalette() const
+{
+	return m_palette;
+}
+
+void Texture::SetPaletteRow(unsigned int paletteRow)
+{
+	m_uiPaletteRow = paletteRow;
+}
+
+unsigned int Texture::GetPaletteRow() const
+{
+	return m_uiPaletteRow;
+}
+
 void
 Texture::LoadTextTexture(const char* text, const char* fontname, int pointsize)
 {
@@ -142,6 +333,18 @@ Texture::LoadTextTexture(const char* text, const char* fontname, int pointsize)
 		return;
 	}
 
+	if (sm_bHeadless)
+	{
+		// Laid out, not rasterised
+		if (TTF_SizeText(pFont, text, &m_iWidth, &m_iHeight) != 0)
+		{
+			LogManager::GetInstance().Log("Failed to render text!");
+		}
+
+		TTF_CloseFont(pFont);
+		return;
+	}
+
 	SDL_Color color;
 	color.r = 255;
 	color.g = 255;
@@ -157,18 +360,12 @@ Texture::LoadTextTexture(const char* text, const char* fontname, int pointsize)
 		return;
 	}
 
-	GLint previousUnpackAlignment;
-	glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousUnpackAlignment);
-	GLint previousUnpackRowLength;
-	glGetIntegerv(GL_UNPACK_ROW_LENGTH, &previousUnpackRowLength);
-
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // TTF surfaces are byte-aligned
 	glPixelStorei(GL_UNPACK_ROW_LENGTH, pSurface->pitch / pSurface->format->BytesPerPixel);
 
 	LoadSurfaceIntoTexture(pSurface);
 
-	glPixelStorei(GL_UNPACK_ALIGNMENT, previousUnpackAlignment);
-	glPixelStorei(GL_UNPACK_ROW_LENGTH, previousUnpackRowLength);
+	RestoreDefaultUnpackState();
 
 	TTF_CloseFont(pFont);
 	pFont = 0;
@@ -177,13 +374,27 @@ Texture::LoadTextTexture(const char* text, const char* fontname, int pointsize)
 void
 Texture::LoadSurfaceIntoTexture(SDL_Surface* pSurface)
 {
+	if (pSurface && sm_bHeadless)
+	{
+		m_iWidth = pSurface->w;
+		m_iHeight = pSurface->h;
+		SDL_FreeSurface(pSurface);
+		return;
+	}
+
 	if (pSurface)
 	{
-		if (m_uiTextureId != 0)
+		if (m_bOwnsTexture)
 		{
-			glDeleteTextures(1, &m_uiTextureId);
-			m_uiTextureId = 0;
+			RenderThread::GetInstance().DeleteTexture(m_uiTextureId);
 		}
+		m_uiTextureId = 0;
+		m_bOwnsTexture = true;
+		m_iRegionX = 0;
+		m_iRegionY = 0;
+
+		m_palette.clear();
+		m_uiPaletteRow = PaletteAtlas::NO_PALETTE;
 
 		m_iWidth = pSurface->w;
 		m_iHeight = pSurface->h;
@@ -213,14 +424,76 @@ Texture::LoadSurfaceIntoTexture(SDL_Surface* pSurface)
 		}
 
 		glGenTextures(1, &m_uiTextureId); 
-		glBindTexture(GL_TEXTURE_2D, m_uiTextureId);
+		GLStateCache::GetInstance().BindTexture(0, m_uiTextureId);
 
 		glTexImage2D(GL_TEXTURE_2D, 0, internalGlFormat, m_iWidth, m_iHeight, 0, surfacePixelGlFormat, GL_UNSIGNED_BYTE, pSurface->pixels);
+		GLStateCache::GetInstance().GetStats().AddTextUpload(m_iWidth * m_iHeight * pSurface->format->BytesPerPixel);
 		
 		SDL_FreeSurface(pSurface); 
 		pSurface = 0;
 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST); 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+		RenderThread::GetInstance().OnTextureUploaded();
 	}
-}
\ No newline at end of file
+}
+
+void
+Texture::SetHeadless(bool headless)
+{
+	sm_bHeadless = headless;
+}
+
+bool
+Texture::IsHeadless()
+{
+	return sm_bHeadless;
+}
+
+bool
+Texture::ReadImageSize(const char* pcFilename, int& width, int& height)
+{
+	// Every image the game ships is a PNG: the size is in the IHDR chunk, right after the signature
+	std::ifstream file(pcFilename, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	unsigned char header[24];
+	file.read(reinterpret_cast<char*>(header), sizeof(header));
+
+	const unsigned char PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+	if (file.good() && memcmp(header, PNG_SIGNATURE, 8) == 0 && memcmp(header + 12, "IHDR", 4) == 0)
+	{
+		// Big endian
+		width = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+		height = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+		return true;
+	}
+
+	// Anything else is decoded to find out, still without GL
+	SDL_Surface* pSurface = IMG_Load(pcFilename);
+
+	if (pSurface == 0)
+	{
+		return false;
+	}
+
+	width = pSurface->w;
+	height = pSurface->h;
+	SDL_FreeSurface(pSurface);
+
+	return true;
+}
+
+void
+Texture::RestoreDefaultUnpackState()
+{
+	// Back to the GL defaults rather than querying what was set before, every upload sets its own state
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+}
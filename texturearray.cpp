@@ -0,0 +1,204 @@
+// COMP710 GP Framework 2025
+
+// This include:
+#include "texturearray.h"
+
+// Local includes:
+#include "logmanager.h"
+#include "glstatecache.h"
+#include "renderthread.h"
+#include "paletteatlas.h"
+
+// Library includes:
+#include <SDL_image.h>
+#include <cassert>
+#include <glew.h>
+
+TextureArray::TextureArray()
+	: m_uiTextureId(0)
+	, m_iFrameWidth(0)
+	, m_iFrameHeight(0)
+	, m_iLayerCount(0)
+	, m_bIndexed(false)
+{
+}
+
+TextureArray::~TextureArray()
+{
+	// Deferred while the render thread may still be drawing with it
+	RenderThread::GetInstance().DeleteTexture(m_uiTextureId);
+	m_uiTextureId = 0;
+}
+
+bool TextureArray::Initialise(const char* const* pcFilenames, int numFiles, int frameWidth, int frameHeight, bool bIndexed)
+{
+	assert(m_uiTextureId == 0);
+	assert(numFiles > 0 && frameWidth > 0 && frameHeight > 0);
+
+	m_iFrameWidth = frameWidth;
+	m_iFrameHeight = frameHeight;
+
+	// Decoded up front, the layer count has to be known before the storage is allocated
+	std::vector<SDL_Surface*> surfaces;
+	surfaces.reserve(numFiles);
+
+	m_firstLayers.clear();
+	m_iLayerCount = 0;
+
+	bool loaded = true;
+
+	for (int k = 0; k < numFiles; ++k)
+	{
+		SDL_Surface* pLoaded = IMG_Load(pcFilenames[k]);
+		SDL_Surface* pSurface = 0;
+
+		if (pLoaded)
+		{
+			// One known byte order for every sheet, whatever each file decoded as
+			pSurface = SDL_ConvertSurfaceFormat(pLoaded, SDL_PIXELFORMAT_RGBA32, 0);
+			SDL_FreeSurface(pLoaded);
+		}
+
+		if (pSurface == 0 || pSurface->w < frameWidth || pSurface->h < frameHeight)
+		{
+			LogManager::GetInstance().Log("Texture array: failed to load a sheet, or it is smaller than one frame!");
+			SDL_FreeSurface(pSurface);
+			loaded = false;
+			break;
+		}
+
+		m_firstLayers.push_back(m_iLayerCount);
+		m_iLayerCount += (pSurface->w / frameWidth) * (pSurface->h / frameHeight);
+
+		surfaces.push_back(pSurface);
+	}
+
+	GLint maxLayers = 0;
+	glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+
+	if (loaded && m_iLayerCount > maxLayers)
+	{
+		LogManager::GetInstance().Log("Texture array: more frames than GL_MAX_ARRAY_TEXTURE_LAYERS!");
+		loaded = false;
+	}
+
+	// Indexed the same way Texture does it, so each sheet's indices match its own palette
+	std::vector< std::vector<unsigned char> > sheetIndices;
+	m_bIndexed = false;
+
+	if (loaded && bIndexed)
+	{
+		m_bIndexed = true;
+		sheetIndices.resize(surfaces.size());
+
+		std::vector<unsigned int> palette;
+
+		for (size_t k = 0; k < surfaces.size() && m_bIndexed; ++k)
+		{
+			SDL_Surface* pSurface = surfaces[k];
+			m_bIndexed = PaletteAtlas::IndexPixels(static_cast<const unsigned char*>(pSurface->pixels)
+				, pSurface->w, pSurface->h, pSurface->pitch, palette, sheetIndices[k]);
+		}
+	}
+
+	if (loaded)
+	{
+		const GLenum internalFormat = m_bIndexed ? GL_R8 : GL_RGBA8;
+		const GLenum pixelFormat = m_bIndexed ? GL_RED : GL_RGBA;
+		const int bytesPerPixel = m_bIndexed ? 1 : 4;
+
+		glGenTextures(1, &m_uiTextureId);
+		GLStateCache::GetInstance().BindTextureArray(0, m_uiTextureId);
+
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, internalFormat, frameWidth, frameHeight, m_iLayerCount, 0, pixelFormat, GL_UNSIGNED_BYTE, 0);
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		for (size_t k = 0; k < surfaces.size(); ++k)
+		{
+			SDL_Surface* pSurface = surfaces[k];
+			const int framesWide = pSurface->w / frameWidth;
+			const int framesHigh = pSurface->h / frameHeight;
+			const unsigned char* pPixels = m_bIndexed ? sheetIndices[k].data() : static_cast<const unsigned char*>(pSurface->pixels);
+			const int pitch = m_bIndexed ? pSurface->w : pSurface->pitch;
+
+			// Each frame is a sub-rectangle of the sheet, the row length steps over the rest of it
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, pitch / bytesPerPixel);
+
+			int layer = m_firstLayers[k];
+
+			for (int h = 0; h < framesHigh; ++h)
+			{
+				for (int w = 0; w < framesWide; ++w)
+				{
+					const unsigned char* pFrame = pPixels + (h * frameHeight * pitch) + (w * frameWidth * bytesPerPixel);
+
+					glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, frameWidth, frameHeight, 1, pixelFormat, GL_UNSIGNED_BYTE, pFrame);
+					GLStateCache::GetInstance().GetStats().AddTextureUpload(frameWidth * frameHeight * bytesPerPixel);
+					++layer;
+				}
+			}
+		}
+
+		RestoreDefaultUnpackState();
+
+		// NOTE: Must be GL_NEAREST, same as the sheets, or neighbouring pixels bleed into pixel art
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		RenderThread::GetInstance().OnTextureUploaded();
+	}
+
+	for (size_t k = 0; k < surfaces.size(); ++k)
+	{
+		SDL_FreeSurface(surfaces[k]);
+	}
+
+	if (!loaded)
+	{
+		m_firstLayers.clear();
+		m_iLayerCount = 0;
+	}
+
+	return loaded;
+}
+
+unsigned int TextureArray::GetTextureId() const
+{
+	return (m_uiTextureId);
+}
+
+int TextureArray::GetFrameWidth() const
+{
+	return (m_iFrameWidth);
+}
+
+int TextureArray::GetFrameHeight() const
+{
+	return (m_iFrameHeight);
+}
+
+int TextureArray::GetLayerCount() const
+{
+	return (m_iLayerCount);
+}
+
+bool TextureArray::IsIndexed() const
+{
+	return m_bIndexed;
+}
+
+int TextureArray::GetFirstLayer(int fileIndex) const
+{
+	assert(fileIndex >= 0 && fileIndex < static_cast<int>(m_firstLayers.size()));
+
+	return m_firstLayers[fileIndex];
+}
+
+void TextureArray::RestoreDefaultUnpackState()
+{
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+}
@@ -5,13 +5,21 @@
 
 // Local includes:
 #include "texture.h"
+#include "texturearray.h"
+#include "glstatecache.h"
+#include "paletteatlas.h"
+#include "atlasmanifest.h"
 #include "logmanager.h"
 
 // Library includes:
 #include <cassert>
 #include <SDL.h>
+#include <glew.h>
+#include <vector>
 
 TextureManager::TextureManager()
+	: m_pPaletteAtlas(0)
+	, m_pAtlasManifest(0)
 {
 
 }
@@ -29,12 +37,71 @@ TextureManager::~TextureManager()
 	}
 
 	m_pLoadedTextures.clear();
+
+	for (size_t k = 0; k < m_atlasPages.size(); ++k)
+	{
+		delete m_atlasPages[k];
+	}
+
+	m_atlasPages.clear();
+
+	delete m_pAtlasManifest;
+	m_pAtlasManifest = 0;
+
+	std::map<FrameTableKey, FrameTable*>::iterator frameIter = m_frameTables.begin();
+
+	while (frameIter != m_frameTables.end())
+	{
+		delete frameIter->second;
+
+		++frameIter;
+	}
+
+	m_frameTables.clear();
+
+	std::map<std::string, TextureArray*>::iterator arrayIter = m_textureArrays.begin();
+
+	while (arrayIter != m_textureArrays.end())
+	{
+		delete arrayIter->second;
+
+		++arrayIter;
+	}
+
+	m_textureArrays.clear();
+	m_textureArrayLayers.clear();
+
+	delete m_pPaletteAtlas;
+	m_pPaletteAtlas = 0;
 }
 
 bool TextureManager::Initialize()
 {
 	LogManager::GetInstance().Log("TextureManager starting...");
 
+	// Headless textures have no pixels to index
+	m_pPaletteAtlas = Texture::IsHeadless() ? 0 : new PaletteAtlas();
+
+	if (m_pPaletteAtlas && !m_pPaletteAtlas->Initialise())
+	{
+		LogManager::GetInstance().Log("Palette atlas failed to initialize, textures load as RGBA.");
+		delete m_pPaletteAtlas;
+		m_pPaletteAtlas = 0;
+	}
+
+	m_pAtlasManifest = new AtlasManifest();
+
+	if (m_pAtlasManifest->Load("assets/atlas/atlas.bin"))
+	{
+		m_atlasPages.resize(m_pAtlasManifest->GetPageCount(), 0);
+	}
+	else
+	{
+		LogManager::GetInstance().Log("No texture atlas, textures load individually.");
+		delete m_pAtlasManifest;
+		m_pAtlasManifest = 0;
+	}
+
 	return true;
 }
 
@@ -44,15 +111,16 @@ Texture* TextureManager::GetTexture(const char* pcFilename)
 
 	if (m_pLoadedTextures.find(pcFilename) == m_pLoadedTextures.end())
 	{
-		// Not already loaded... so load...
-		pTexture = new Texture();
-		if (!pTexture->Initialise(pcFilename))
+		// Not already loaded... so cut it from the atlas, or load it on its own
+		pTexture = LoadAtlasRegion(pcFilename);
+
+		if (pTexture == 0)
 		{
-			LogManager::GetInstance().Log("Texture failed to initialize!");
-			assert(0);
+			pTexture = LoadTexture(pcFilename);
 		}
 
 		m_pLoadedTextures[pcFilename] = pTexture;
+		LoadManifestTrims(pcFilename, *pTexture);
 	}
 	else
 	{
@@ -63,8 +131,442 @@ Texture* TextureManager::GetTexture(const char* pcFilename)
 	return pTexture;
 }
 
+Texture*
+TextureManager::LoadTexture(const char* pcFilename)
+{
+	// Indexed if it has few enough colours and there is a palette row free
+	bool bAllowIndexed = (m_pPaletteAtlas != 0 && !m_pPaletteAtlas->IsFull());
+
+	Texture* pTexture = new Texture();
+	if (!pTexture->Initialise(pcFilename, bAllowIndexed))
+	{
+		LogManager::GetInstance().Log("Texture failed to initialize!");
+		assert(0);
+	}
+
+	if (pTexture->IsIndexed())
+	{
+		pTexture->SetPaletteRow(m_pPaletteAtlas->AddPalette(pTexture->GetPalette()));
+	}
+
+	return pTexture;
+}
+
+Texture*
+TextureManager::LoadAtlasRegion(const char* pcFilename)
+{
+	if (m_pAtlasManifest == 0)
+	{
+		return 0;
+	}
+
+	const AtlasRegion* pRegion = m_pAtlasManifest->FindRegion(pcFilename);
+
+	if (pRegion == 0)
+	{
+		// Not packed, e.g. added to the game after the atlas was last built
+		return 0;
+	}
+
+	if (m_atlasPages[pRegion->page] == 0)
+	{
+		m_atlasPages[pRegion->page] = LoadTexture(m_pAtlasManifest->GetPagePath(pRegion->page).c_str());
+	}
+
+	Texture* pTexture = new Texture();
+
+	if (!pTexture->InitialiseRegion(*m_atlasPages[pRegion->page], pRegion->x, pRegion->y, pRegion->width, pRegion->height))
+	{
+		// Stale manifest... the original file is still there to fall back on
+		delete pTexture;
+		return 0;
+	}
+
+	return pTexture;
+}
+
 void
 TextureManager::AddTexture(const char* key, Texture* pTexture)
 {
 	m_pLoadedTextures[key] = pTexture;
-}
\ No newline at end of file
+}
+
+const FrameTable*
+TextureManager::AcquireFrameTable(Texture& texture, int frameWidth, int frameHeight)
+{
+	FrameTableKey key;
+	key.pTexture = &texture;
+	key.frameWidth = frameWidth;
+	key.frameHeight = frameHeight;
+
+	FrameTable* pFrameTable = 0;
+
+	std::map<FrameTableKey, FrameTable*>::iterator iter = m_frameTables.find(key);
+
+	if (iter == m_frameTables.end())
+	{
+		// First sprite using this sheet and frame size... so build the table
+		pFrameTable = new FrameTable();
+		pFrameTable->pTexture = &texture;
+		pFrameTable->frameWidth = frameWidth;
+		pFrameTable->frameHeight = frameHeight;
+		pFrameTable->refCount = 0;
+		LinkTextureArray(*pFrameTable);
+		RestoreUnlinkedSheet(*pFrameTable);
+		BuildFrameTable(*pFrameTable);
+
+		m_frameTables[key] = pFrameTable;
+	}
+	else
+	{
+		pFrameTable = iter->second;
+	}
+
+	++pFrameTable->refCount;
+
+	return pFrameTable;
+}
+
+void
+TextureManager::ReleaseFrameTable(const FrameTable* pFrameTable)
+{
+	if (pFrameTable == 0)
+	{
+		return;
+	}
+
+	FrameTableKey key;
+	key.pTexture = pFrameTable->pTexture;
+	key.frameWidth = pFrameTable->frameWidth;
+	key.frameHeight = pFrameTable->frameHeight;
+
+	std::map<FrameTableKey, FrameTable*>::iterator iter = m_frameTables.find(key);
+	assert(iter != m_frameTables.end() && iter->second == pFrameTable);
+
+	FrameTable* pOwned = iter->second;
+	--pOwned->refCount;
+
+	if (pOwned->refCount <= 0)
+	{
+		delete pOwned;
+		m_frameTables.erase(iter);
+	}
+}
+
+void
+TextureManager::LoadManifestTrims(const char* pcFilename, const Texture& texture)
+{
+	if (m_pAtlasManifest == 0)
+	{
+		return;
+	}
+
+	const AtlasFrameTrims* pFrameTrims = m_pAtlasManifest->FindFrameTrims(pcFilename);
+
+	if (pFrameTrims == 0)
+	{
+		return;
+	}
+
+	const int totalFrames = (texture.GetWidth() / pFrameTrims->frameWidth) * (texture.GetHeight() / pFrameTrims->frameHeight);
+
+	if (static_cast<int>(pFrameTrims->trims.size()) != totalFrames)
+	{
+		// The sheet changed size since the atlas was built, its trims get read back instead
+		return;
+	}
+
+	FrameTableKey key;
+	key.pTexture = &texture;
+	key.frameWidth = pFrameTrims->frameWidth;
+	key.frameHeight = pFrameTrims->frameHeight;
+
+	m_frameTrims[key] = pFrameTrims->trims;
+}
+
+const std::vector<FrameTrim>&
+TextureManager::GetFrameTrims(const Texture& texture, int frameWidth, int frameHeight)
+{
+	FrameTableKey key;
+	key.pTexture = &texture;
+	key.frameWidth = frameWidth;
+	key.frameHeight = frameHeight;
+
+	std::map<FrameTableKey, std::vector<FrameTrim> >::iterator trimIter = m_frameTrims.find(key);
+
+	if (trimIter == m_frameTrims.end())
+	{
+		// Not trimmed by the atlas build at this size... so read each frame's opaque bounds back
+		trimIter = m_frameTrims.insert(std::make_pair(key, std::vector<FrameTrim>())).first;
+		ReadBackFrameTrims(texture, frameWidth, frameHeight, trimIter->second);
+	}
+
+	return trimIter->second;
+}
+
+void
+TextureManager::BuildFrameTable(FrameTable& frameTable)
+{
+	const int textureWidth = frameTable.pTexture->GetWidth();
+	const int textureHeight = frameTable.pTexture->GetHeight();
+	const int totalFramesWide = textureWidth / frameTable.frameWidth;
+	const int totalFramesHigh = textureHeight / frameTable.frameHeight;
+
+	frameTable.trims = GetFrameTrims(*frameTable.pTexture, frameTable.frameWidth, frameTable.frameHeight);
+
+	const float uPixel = 1.0f / textureWidth;
+	const float vPixel = 1.0f / textureHeight;
+
+	frameTable.frames.clear();
+	frameTable.frames.reserve(totalFramesWide * totalFramesHigh);
+
+	for (int h = 0; h < totalFramesHigh; ++h)
+	{
+		for (int w = 0; w < totalFramesWide; ++w)
+		{
+			const FrameTrim& trim = frameTable.trims[frameTable.frames.size()];
+
+			int left = (w * frameTable.frameWidth) + trim.x;
+			int top = (h * frameTable.frameHeight) + trim.y;
+
+			// v0 is the bottom of the frame, sprite.vert puts it at the bottom of the quad
+			SpriteUVRect frame;
+			frame.u0 = frameTable.pTexture->MapU(left * uPixel);
+			frame.v0 = frameTable.pTexture->MapV((top + trim.height) * vPixel);
+			frame.u1 = frameTable.pTexture->MapU((left + trim.width) * uPixel);
+			frame.v1 = frameTable.pTexture->MapV(top * vPixel);
+
+			frameTable.frames.push_back(frame);
+		}
+	}
+}
+
+void
+TextureManager::ReadBackFrameTrims(const Texture& texture, int frameWidth, int frameHeight, std::vector<FrameTrim>& trims)
+{
+	const int textureWidth = texture.GetWidth();
+	const int textureHeight = texture.GetHeight();
+
+	if (Texture::IsHeadless())
+	{
+		// Nothing to read back, every frame keeps its full bounds
+		const FrameTrim fullFrame = { 0, 0, frameWidth, frameHeight };
+		trims.assign((textureWidth / frameWidth) * (textureHeight / frameHeight), fullFrame);
+		return;
+	}
+
+	// An atlas region reads back its whole page, GL can't read part of a texture level here
+	int regionX = 0;
+	int regionY = 0;
+	int readWidth = 0;
+	int readHeight = 0;
+	texture.GetRegion(regionX, regionY, readWidth, readHeight);
+
+	// Only for sheets the atlas build step didn't trim: GL already has the only decoded copy of the pixels
+	const size_t numPixels = static_cast<size_t>(readWidth) * readHeight;
+	const size_t regionOffset = static_cast<size_t>(regionY) * readWidth + regionX;
+
+	GLStateCache::GetInstance().BindTexture(0, texture.GetTextureId());
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+	if (texture.IsIndexed())
+	{
+		// Indices read back as they are, their alpha is in the palette
+		std::vector<unsigned char> indices(numPixels);
+		glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_BYTE, &indices[0]);
+
+		const std::vector<unsigned int>& palette = texture.GetPalette();
+		std::vector<unsigned char> alphas(numPixels);
+
+		for (size_t k = 0; k < numPixels; ++k)
+		{
+			alphas[k] = reinterpret_cast<const unsigned char*>(&palette[indices[k]])[3];
+		}
+
+		TrimFrames(&alphas[regionOffset], 1, readWidth, textureWidth, textureHeight, frameWidth, frameHeight, trims);
+	}
+	else
+	{
+		std::vector<unsigned char> pixels(numPixels * 4);
+		glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+
+		TrimFrames(&pixels[regionOffset * 4 + 3], 4, readWidth * 4, textureWidth, textureHeight, frameWidth, frameHeight, trims);
+	}
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+}
+
+void
+TextureManager::TrimFrames(const unsigned char* pAlpha, int pixelBytes, int pitch, int sheetWidth, int sheetHeight
+	, int frameWidth, int frameHeight, std::vector<FrameTrim>& trims)
+{
+	const int totalFramesWide = sheetWidth / frameWidth;
+	const int totalFramesHigh = sheetHeight / frameHeight;
+
+	trims.clear();
+	trims.reserve(totalFramesWide * totalFramesHigh);
+
+	for (int h = 0; h < totalFramesHigh; ++h)
+	{
+		for (int w = 0; w < totalFramesWide; ++w)
+		{
+			int minX = frameWidth;
+			int minY = frameHeight;
+			int maxX = -1;
+			int maxY = -1;
+
+			for (int y = 0; y < frameHeight; ++y)
+			{
+				const unsigned char* pRow = pAlpha + (static_cast<size_t>(h * frameHeight) + y) * pitch + static_cast<size_t>(w * frameWidth) * pixelBytes;
+
+				for (int x = 0; x < frameWidth; ++x)
+				{
+					if (pRow[x * pixelBytes] != 0)
+					{
+						minX = (x < minX) ? x : minX;
+						maxX = (x > maxX) ? x : maxX;
+						minY = (y < minY) ? y : minY;
+						maxY = y;
+					}
+				}
+			}
+
+			FrameTrim trim = { 0, 0, 0, 0 };
+
+			if (maxX >= 0)
+			{
+				trim.x = minX;
+				trim.y = minY;
+				trim.width = maxX - minX + 1;
+				trim.height = maxY - minY + 1;
+			}
+
+			trims.push_back(trim);
+		}
+	}
+}
+
+void
+TextureManager::LinkTextureArray(FrameTable& frameTable) const
+{
+	frameTable.arrayTextureId = 0;
+	frameTable.firstLayer = 0;
+	frameTable.bArrayIndexed = false;
+
+	std::map<const Texture*, TextureArrayLayers>::const_iterator iter = m_textureArrayLayers.find(frameTable.pTexture);
+
+	if (iter == m_textureArrayLayers.end())
+	{
+		return;
+	}
+
+	// Layers are cut at the array's frame size, a sheet read at any other size stays 2D
+	const TextureArray* pTextureArray = iter->second.pTextureArray;
+
+	if (pTextureArray->GetFrameWidth() == frameTable.frameWidth && pTextureArray->GetFrameHeight() == frameTable.frameHeight)
+	{
+		frameTable.arrayTextureId = pTextureArray->GetTextureId();
+		frameTable.firstLayer = iter->second.firstLayer;
+		frameTable.bArrayIndexed = pTextureArray->IsIndexed();
+	}
+}
+
+void
+TextureManager::RestoreUnlinkedSheet(const FrameTable& frameTable)
+{
+	if (frameTable.arrayTextureId != 0 || !frameTable.pTexture->IsStorageReleased())
+	{
+		return;
+	}
+
+	// Read at a size other than the array's, so this table trims and draws from the 2D sheet after all
+	frameTable.pTexture->RestoreStorage();
+}
+
+const TextureArray*
+TextureManager::CreateTextureArray(const char* pcFamily, const char* const* pcFilenames, int numFiles, int frameWidth, int frameHeight)
+{
+	std::map<std::string, TextureArray*>::iterator iter = m_textureArrays.find(pcFamily);
+
+	if (iter != m_textureArrays.end())
+	{
+		// Already built (or already failed) for another entity of this family
+		return iter->second;
+	}
+
+	if (Texture::IsHeadless())
+	{
+		// Sheets stay 2D, which draws the same frames without a GL array to build
+		m_textureArrays[pcFamily] = 0;
+		return 0;
+	}
+
+	// Indexed layers reuse each sheet's palette row, so every sheet must already be indexed on its own.
+	// An atlas region's palette is its page's, which the array doesn't index the sheet with.
+	bool bIndexed = true;
+
+	for (int k = 0; k < numFiles; ++k)
+	{
+		const Texture* pSheet = GetTexture(pcFilenames[k]);
+		bIndexed = pSheet->IsIndexed() && !pSheet->IsRegion() && bIndexed;
+	}
+
+	TextureArray* pTextureArray = new TextureArray();
+
+	if (!pTextureArray->Initialise(pcFilenames, numFiles, frameWidth, frameHeight, bIndexed))
+	{
+		LogManager::GetInstance().Log("Texture array failed to initialize, its sheets draw as 2D textures.");
+		delete pTextureArray;
+
+		m_textureArrays[pcFamily] = 0;
+		return 0;
+	}
+
+	m_textureArrays[pcFamily] = pTextureArray;
+
+	for (int k = 0; k < numFiles; ++k)
+	{
+		TextureArrayLayers layers;
+		layers.pTextureArray = pTextureArray;
+		layers.firstLayer = pTextureArray->GetFirstLayer(k);
+
+		// The array holds every frame, keeping the 2D sheet too would cost the family twice the VRAM.
+		// The Texture stays for its size, palette and as the frame tables' key. Trims the atlas build
+		// didn't provide are read back now, while there is still a 2D texture to read them from.
+		Texture* pSheet = GetTexture(pcFilenames[k]);
+		GetFrameTrims(*pSheet, frameWidth, frameHeight);
+		pSheet->ReleaseStorage();
+
+		m_textureArrayLayers[pSheet] = layers;
+	}
+
+	// Frame tables built before the array existed switch over to it too, those read at another size get their 2D sheet back
+	std::map<FrameTableKey, FrameTable*>::iterator frameIter = m_frameTables.begin();
+
+	while (frameIter != m_frameTables.end())
+	{
+		LinkTextureArray(*frameIter->second);
+		RestoreUnlinkedSheet(*frameIter->second);
+
+		++frameIter;
+	}
+
+	return pTextureArray;
+}
+
+unsigned int
+TextureManager::AddPalette(const std::vector<unsigned int>& colours)
+{
+	if (m_pPaletteAtlas == 0)
+	{
+		return PaletteAtlas::NO_PALETTE;
+	}
+
+	return m_pPaletteAtlas->AddPalette(colours);
+}
+
+unsigned int
+TextureManager::GetPaletteTextureId() const
+{
+	return m_pPaletteAtlas ? m_pPaletteAtlas->GetTextureId() : 0;
+}
@@ -4,63 +4,223 @@
 #include "vertexarray.h"
 
 // Local includes:
+#include "glstatecache.h"
 
 // Library includes:
 #include <glew.h>
 #include <cassert>
+#include <cstring>
 
-VertexArray::VertexArray(const float* pVertexData, unsigned int numVertices, const unsigned int* pIndexData, unsigned int numIndices)
-	: m_numVertices(numVertices)
-	, m_numIndices(numIndices)
-	, m_glVertexBuffer(0)
-	, m_glIndexBuffer(0)
-	, m_glVertexArray(0)
+void EnableVertexFormat(const VertexFormat& format)
 {
-	const int stride = 5 * sizeof(float); // XYZUV
+	for (unsigned int k = 0; k < format.numAttributes; ++k)
+	{
+		const VertexAttribute& attribute = format.pAttributes[k];
+
+		glEnableVertexAttribArray(attribute.location);
+		glVertexAttribDivisor(attribute.location, format.divisor);
+	}
+}
+
+void PointVertexFormat(const VertexFormat& format, size_t baseOffset)
+{
+	for (unsigned int k = 0; k < format.numAttributes; ++k)
+	{
+		const VertexAttribute& attribute = format.pAttributes[k];
+
+		glVertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized
+			, format.stride, reinterpret_cast<void*>(baseOffset + attribute.offset));
+	}
+}
+
+unsigned short FloatToHalf(float value)
+{
+	unsigned int bits = 0;
+	memcpy(&bits, &value, sizeof(bits));
+
+	unsigned int sign = (bits >> 16) & 0x8000;
+	int exponent = static_cast<int>((bits >> 23) & 0xFF) - 127 + 15;
+	unsigned int mantissa = bits & 0x007FFFFF;
+
+	if (exponent <= 0)
+	{
+		// Too small for a normal half, flush to signed zero
+		return static_cast<unsigned short>(sign);
+	}
+
+	if (exponent >= 31)
+	{
+		// Overflow, infinity and NaN all become infinity
+		return static_cast<unsigned short>(sign | 0x7C00);
+	}
+
+	// Round to nearest, a carry out of the mantissa correctly bumps the exponent
+	unsigned int half = sign | (static_cast<unsigned int>(exponent) << 10) | (mantissa >> 13);
+
+	if (mantissa & 0x00001000)
+	{
+		++half;
+	}
+
+	return static_cast<unsigned short>(half);
+}
+
+StreamingBuffer::StreamingBuffer()
+	: m_glBuffer(0)
+	, m_partitionSize(0)
+	, m_partition(0)
+	, m_offset(0)
+	, m_pMapped(0)
+{
+	for (unsigned int k = 0; k < NUM_PARTITIONS; ++k)
+	{
+		m_fences[k] = 0;
+	}
+}
+
+StreamingBuffer::~StreamingBuffer()
+{
+	for (unsigned int k = 0; k < NUM_PARTITIONS; ++k)
+	{
+		if (m_fences[k] != 0)
+		{
+			glDeleteSync(m_fences[k]);
+			m_fences[k] = 0;
+		}
+	}
+
+	if (m_pMapped)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_glBuffer);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+		m_pMapped = 0;
+	}
 
-	assert(pVertexData);
+	glDeleteBuffers(1, &m_glBuffer);
+}
+
+bool StreamingBuffer::Initialise(unsigned int partitionSize)
+{
+	assert(partitionSize > 0);
+	m_partitionSize = partitionSize;
 
-	glGenVertexArrays(1, &m_glVertexArray);
-	glBindVertexArray(m_glVertexArray);
+	const GLsizeiptr totalSize = static_cast<GLsizeiptr>(m_partitionSize) * NUM_PARTITIONS;
 
-	glGenBuffers(1, &m_glVertexBuffer);
-	glBindBuffer(GL_ARRAY_BUFFER, m_glVertexBuffer);
-	glBufferData(GL_ARRAY_BUFFER, m_numVertices * stride, pVertexData, GL_STATIC_DRAW);
+	glGenBuffers(1, &m_glBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, m_glBuffer);
 
-	if (pIndexData)
+	if (GLEW_ARB_buffer_storage)
 	{
-		glGenBuffers(1, &m_glIndexBuffer);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_glIndexBuffer);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_numIndices * sizeof(unsigned int), pIndexData, GL_STATIC_DRAW);
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glBufferStorage(GL_ARRAY_BUFFER, totalSize, 0, flags);
+		m_pMapped = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, totalSize, flags));
+
+		if (m_pMapped == 0)
+		{
+			// Storage is immutable once specified, start again with a plain buffer
+			glDeleteBuffers(1, &m_glBuffer);
+			glGenBuffers(1, &m_glBuffer);
+			glBindBuffer(GL_ARRAY_BUFFER, m_glBuffer);
+		}
 	}
 
-	// Layout: XYZ
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, 0);
+	if (m_pMapped == 0)
+	{
+		glBufferData(GL_ARRAY_BUFFER, totalSize, 0, GL_STREAM_DRAW);
+	}
 
-	// Layout: UV
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(sizeof(float) * 3));
+	return true;
 }
 
-VertexArray::~VertexArray()
+unsigned int StreamingBuffer::Upload(const void* pData, unsigned int size, unsigned int alignment)
 {
-	glDeleteBuffers(1, &m_glVertexBuffer);
-	glDeleteBuffers(1, &m_glIndexBuffer);
-	glDeleteVertexArrays(1, &m_glVertexArray);
+	assert(size > 0);
+	assert(alignment > 0);
+
+	unsigned int start = m_partition * m_partitionSize;
+	unsigned int offset = ((start + m_offset + alignment - 1) / alignment) * alignment;
+
+	if (offset + size > start + m_partitionSize)
+	{
+		NextPartition();
+
+		start = m_partition * m_partitionSize;
+		offset = ((start + alignment - 1) / alignment) * alignment;
+	}
+
+	assert(offset + size <= start + m_partitionSize); // Partition too small for one upload
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_glBuffer);
+
+	if (m_pMapped)
+	{
+		memcpy(m_pMapped + offset, pData, size);
+	}
+	else
+	{
+		// Nothing in flight reads this range since the last orphan, so there is nothing to wait for
+		void* pDestination = glMapBufferRange(GL_ARRAY_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		assert(pDestination);
+		memcpy(pDestination, pData, size);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+	}
+
+	m_offset = offset + size - start;
+
+	GLStateCache::GetInstance().GetStats().bytesUploaded += size;
+
+	return offset;
+}
+
+void StreamingBuffer::NextPartition()
+{
+	if (m_pMapped)
+	{
+		// Every draw reading the partition being left has been issued by now
+		m_fences[m_partition] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	m_partition = (m_partition + 1) % NUM_PARTITIONS;
+	m_offset = 0;
+
+	if (m_pMapped)
+	{
+		GLsync fence = m_fences[m_partition];
+
+		if (fence != 0)
+		{
+			const GLuint64 ONE_SECOND = 1000000000;
+			GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, ONE_SECOND);
+
+			while (result == GL_TIMEOUT_EXPIRED)
+			{
+				result = glClientWaitSync(fence, 0, ONE_SECOND);
+			}
+
+			glDeleteSync(fence);
+			m_fences[m_partition] = 0;
+		}
+	}
+	else if (m_partition == 0)
+	{
+		// The driver hands back fresh storage, draws still in flight keep the old one
+		glBindBuffer(GL_ARRAY_BUFFER, m_glBuffer);
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_partitionSize) * NUM_PARTITIONS, 0, GL_STREAM_DRAW);
+	}
 }
 
-void VertexArray::SetActive()
+unsigned int StreamingBuffer::GetBuffer() const
 {
-	glBindVertexArray(m_glVertexArray);
+	return m_glBuffer;
 }
 
-unsigned int VertexArray::GetNumVertices() const
+unsigned int StreamingBuffer::GetPartitionSize() const
 {
-	return m_numVertices;
+	return m_partitionSize;
 }
 
-unsigned int VertexArray::GetNumIndices() const
+bool StreamingBuffer::IsPersistent() const
 {
-	return m_numIndices;
-}
\ No newline at end of file
+	return (m_pMapped != 0);
+}